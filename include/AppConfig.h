@@ -31,15 +31,104 @@ const IPAddress DNS_SERVER(8, 8, 8, 8);
 // --- System Constants ---
 const char* const WIFI_SSID = "YOUR_SSID";
 const char* const WIFI_PASS = "YOUR_PASSWORD";
-const char* const LOG_FILE_PATH = "/log.txt";
+const char* const LOG_FILE_PATH = "/log.txt";      // Legacy text log, migrated on boot
+
+// Per-sensor files; %u is replaced by the sensor index. Rings and the
+// archive are series of numbered files in one directory per sensor,
+// named after these prefixes (see LogStore.h).
+const char* const LOG_STORE_PATH = "/log%u/raw";
+const char* const LOG_META_PATH = "/log%u.meta";
+const char* const LOG_INDEX_PATH = "/log%u/idx";
+
+// --- Wi-Fi Link (connected in the background, see WifiLink.h) ---
+const uint32_t WIFI_HINT_TIMEOUT_MS = 4000;      // Attempt with the cached BSSID/channel before a full scan
+const uint32_t WIFI_CONNECT_TIMEOUT_MS = 20000;  // Attempt with a full scan
+const uint32_t WIFI_BACKOFF_MIN_MS = 2000;       // First retry delay; doubles after every failed scan
+const uint32_t WIFI_BACKOFF_MAX_MS = 300000;     // Retry delay cap
+
+// --- Sensor Acquisition ---
+const uint8_t MAX_SENSORS = 4;              // Probes handled on the PIN_DS18B20 bus
+const uint8_t SENSOR_RESOLUTION = 12;       // DS18B20 resolution in bits (9..12)
+const uint32_t SENSOR_PERIOD_MS = 1000;     // Time between conversion starts
+
+// --- Server-Sent Events ---
+const uint8_t SSE_MAX_CLIENTS = 2;          // Concurrent /events subscribers (each holds a TCP PCB)
+const uint32_t SSE_KEEPALIVE_MS = 15000;    // Comment line sent to idle streams
+
+// --- Scheduler & Streamed Responses ---
+const uint8_t SCHED_MAX_TASKS = 10;         // Tasks registered in setup()
+const uint8_t BOOT_MAX_MARKS = 12;          // Boot phases and milestones kept for /diag
+const uint8_t STREAM_MAX_JOBS = 1;          // Concurrent sliced /get_hist or /export responses (more are answered inline)
+const uint16_t STREAM_SLICE_BINS = 16;      // History bins written per slice
+const uint16_t STREAM_SLICE_RECORDS = 64;   // Export records read per slice
+
+// --- TCP Connection Budget ---
+const uint8_t TCP_MAX_PCBS = 5;             // lwIP MEMP_NUM_TCP_PCB of the ESP8266 core
+const uint8_t TCP_RESERVED_PCBS = 2;        // Left for ordinary page and API requests
+static_assert(SSE_MAX_CLIENTS + STREAM_MAX_JOBS + TCP_RESERVED_PCBS <= TCP_MAX_PCBS,
+              "Long-lived connections would starve ordinary requests");
+
+// --- Instrumentation ---
+#ifndef METRICS_ENABLED
+#define METRICS_ENABLED 1               // Latency histograms and heap gauges on /metrics (0 compiles the probes out)
+#endif
+const uint8_t METRICS_MAX_PROBES = 28;      // Fixed probes plus one per web route
+
+// --- Log Storage ---
+const uint32_t FS_BLOCK_BYTES = 8192;  // LittleFS block of the ESP8266 core; files take whole blocks
+const uint32_t LOG_CAPACITY = 44640;   // Records kept in the ring (31 days at 1/min)
+const uint8_t LOG_FLUSH_SAMPLES = 20;  // Samples staged in RAM per sensor before one flash write
+#define LOG_RTC_BACKUP 1               // Mirror staged samples in RTC memory (survives a watchdog reset)
+const uint32_t LOG_INDEX_BUCKET = 3600;                      // Seconds covered by one seek-index entry
+const uint32_t LOG_INDEX_CAPACITY = LOG_CAPACITY / 60 + 24;  // Index entries kept (one per hour, with slack)
+const uint8_t LOG_INDEX_STAGED = 8;                          // Index entries kept in RAM before one write
+const uint32_t LOG_META_INTERVAL = 21600;                    // Seconds of samples between writes of the summary (caught up from the ring after a reset)
+const uint32_t LOG_RETRY_MIN_MS = 60000;     // First retry of a log that could not be written; doubles per failure
+const uint32_t LOG_RETRY_MAX_MS = 3600000;   // Retry delay cap
+const uint32_t LOG_CLOCK_MIN = 1704067200;  // 2024-01-01; an earlier RTC reading means the clock was never set
+const uint32_t LOG_CLOCK_SLACK = 5;         // Seconds a reading may stray from the last one plus the uptime between them before the next must confirm it
+
+// --- Rollup Tiers (pre-aggregated history) ---
+const char* const ROLLUP_5M_PATH = "/log%u/r5m";
+const char* const ROLLUP_1H_PATH = "/log%u/r1h";
+const char* const ROLLUP_1D_PATH = "/log%u/r1d";
+const uint32_t ROLLUP_5M_CAPACITY = 288;   // 1 day of 5-minute bins
+const uint32_t ROLLUP_1H_CAPACITY = 744;   // 31 days of hourly bins
+const uint32_t ROLLUP_1D_CAPACITY = 366;   // 1 year of daily bins
+const uint8_t ROLLUP_STAGED_BINS = 16;     // Closed bins per tier kept in RAM (restored from the raw ring after a reset)
+const uint8_t ROLLUP_FLUSH_BINS = 12;      // Staged bins that get a tier written with the next log flush
+
+// --- Day Archive (compressed raw samples past the ring) ---
+const char* const LOG_ARCHIVE_PATH = "/log%u/arc";
+const uint16_t LOG_ARCHIVE_FILE_DAYS = 32;  // Day segments appended to one file
+const uint8_t LOG_ARCHIVE_FILES = 13;       // Files kept (at least 384 days)
+const uint16_t ARCHIVE_SLICE_RECORDS = 256; // Raw records fed to the segment being sealed per pass
+const uint32_t LOG_ARCHIVE_RESERVE = 16384; // Kept free before a day is sealed (a one-minute day takes at most 14.4 KB)
+
+// --- Config Store ---
+const uint16_t CONFIG_SCHEMA = 5;                // Layout of SystemConfig (1: float EEPROM, 2: "CFG2" EEPROM, 3: no Wi-Fi cache, 4: no probe addresses)
+const uint32_t CONFIG_COMMIT_DELAY_MS = 3000;    // Quiet time after the last change before it is written
+
+/**
+ * @brief Alarm thresholds of one sensor in centi-degrees.
+ */
+struct SensorLimits {
+    int16_t green;
+    int16_t yellow;
+};
 
 /**
- * @brief Configuration structure stored in EEPROM.
+ * @brief Configuration kept in the config journal (see ConfigStore.h).
+ * @details New fields go at the end with CONFIG_SCHEMA raised; records of
+ *          an older schema are shorter and leave them at their defaults.
  */
 struct SystemConfig {
-    float greenLimit;
-    float yellowLimit;
+    uint16_t schema;
+    SensorLimits limits[MAX_SENSORS];
     bool webSoundEnabled;
+    uint8_t wifiBssid[6];  ///< Access point of the last connection
+    uint8_t wifiChannel;   ///< Its channel; 0 if none is cached
+    uint8_t sensorRom[MAX_SENSORS][8];  ///< Probe owning each sensor slot (limits and log); all zero if none
 };
 
 #endif // APP_CONFIG_H
\ No newline at end of file
@@ -0,0 +1,294 @@
+/**
+ * @file WebPagesGz.h
+ * @brief Gzip-compressed pages generated from WebPages.h.
+ * @details Generated by tools/build_web.py - do not edit.
+ */
+
+#ifndef WEB_PAGES_GZ_H
+#define WEB_PAGES_GZ_H
+
+#include <Arduino.h>
+
+// INDEX_HTML: 4856 bytes -> 2063 bytes gzipped
+const uint8_t INDEX_HTML_GZ[] PROGMEM = {
+    0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x8d,0x58,0x4f,0x73,0xdb,0xc6,0x15,0xbf,0xf3,0x53,
+    0x20,0xf4,0x34,0x00,0x2a,0x11,0x04,0x41,0x51,0xa2,0x08,0x82,0xe9,0xc4,0x71,0xa7,0x69,0x95,0x26,0x53,
+    0x29,0x87,0x9e,0x3c,0x4b,0x60,0x41,0x6e,0x0c,0x60,0x31,0xbb,0x4b,0x51,0x2a,0xc5,0x43,0x67,0x62,0xbb,
+    0x07,0x1f,0x7b,0xcf,0xad,0x6a,0x35,0x69,0x5d,0xd7,0x69,0x93,0xf4,0xd0,0x43,0x3f,0x05,0x18,0x7f,0x89,
+    0x7e,0x84,0xbe,0x5d,0x00,0x24,0x40,0x51,0x52,0x46,0x12,0x05,0xec,0xbe,0x7d,0x7f,0x7f,0xef,0xf7,0x56,
+    0x1a,0xbe,0xf7,0xd1,0xa7,0x8f,0xcf,0x7e,0xfb,0xd9,0x13,0x6d,0x2a,0xe2,0x68,0xd4,0x18,0xca,0x5f,0x5a,
+    0x84,0x92,0x89,0xd7,0x0c,0x51,0x53,0x0b,0x08,0xf3,0x9a,0x4c,0x44,0xcd,0xd1,0x70,0x8a,0x51,0x30,0x1a,
+    0xc6,0x58,0x20,0xcd,0x9f,0x22,0xc6,0xb1,0xf0,0x9a,0x9f,0x9f,0xfd,0xbc,0xd5,0x6f,0x16,0xab,0x09,0x8a,
+    0xb1,0xd7,0x3c,0x27,0x78,0x9e,0x52,0x26,0x9a,0x9a,0x4f,0x13,0x81,0x13,0x90,0x9a,0x93,0x40,0x4c,0xbd,
+    0x00,0x9f,0x13,0x1f,0xb7,0xd4,0xcb,0x3e,0x49,0x88,0x20,0x28,0x6a,0x71,0x1f,0x45,0xd8,0xeb,0x34,0xc1,
+    0xb2,0x20,0x22,0xc2,0xa3,0x33,0x1c,0xa7,0xda,0x27,0x14,0xb6,0x29,0x1b,0xb6,0xf3,0xb5,0xc6,0x90,0x8b,
+    0x4b,0xf8,0xfd,0xd3,0x45,0x8c,0xd8,0x84,0x24,0x03,0xdb,0x4d,0x51,0x10,0x90,0x64,0x02,0x4f,0x63,0x7a,
+    0xd1,0xe2,0xe4,0x77,0xf2,0x65,0x4c,0x59,0x80,0x59,0x0b,0x56,0x96,0x63,0x1a,0x5c,0x2e,0x42,0x70,0xa0,
+    0x15,0xa2,0x98,0x44,0x97,0x03,0x81,0xa6,0x34,0x46,0xee,0x18,0xf9,0xcf,0x26,0x8c,0xce,0x92,0x60,0xf0,
+    0x28,0xb4,0x43,0x27,0xec,0xad,0x55,0x75,0xec,0xf4,0xc2,0x8d,0x49,0xd2,0x9a,0x62,0x32,0x99,0x0a,0x78,
+    0xb7,0xcf,0xa7,0xcb,0x86,0x25,0xc3,0x40,0x24,0xc1,0x0c,0xac,0x5f,0xe4,0xee,0x0f,0x0e,0x6d,0x25,0x5c,
+    0x78,0xa3,0xa1,0x99,0xa0,0x4b,0xcb,0x47,0x2c,0x58,0xd4,0x0c,0x84,0xe1,0x5a,0xbb,0x23,0x0f,0x14,0x0e,
+    0x32,0x14,0x90,0x19,0x1f,0x74,0x1c,0xb5,0x04,0xee,0x4f,0x51,0x40,0xe7,0xa0,0x07,0x16,0xb4,0x3e,0xfc,
+    0xb0,0xc9,0x18,0x19,0xf6,0xbe,0xfa,0xb2,0x3a,0x66,0x61,0x08,0x02,0x13,0x82,0xc6,0x83,0x4e,0x2f,0xbd,
+    0x00,0xbf,0x04,0x64,0x2a,0x0f,0x11,0xc2,0xc7,0x03,0x3f,0x42,0x71,0x6a,0x38,0x38,0xde,0xef,0x9f,0xcf,
+    0xf7,0xbb,0x56,0x0f,0xc7,0xa6,0xeb,0xd3,0x88,0xb2,0xc1,0x23,0xdb,0x3e,0x1a,0x83,0x2f,0x4a,0x78,0x9e,
+    0x47,0x37,0xa6,0x51,0x50,0x06,0x20,0x15,0x6a,0x36,0x04,0x10,0x51,0xff,0x59,0x45,0x65,0xc7,0x02,0x75,
+    0xa5,0x8e,0x5e,0xaf,0xb7,0xed,0x87,0xad,0xfc,0xe0,0x02,0x89,0x19,0x5f,0xd4,0xd2,0x58,0x0f,0xb4,0xbf,
+    0xc9,0x95,0xdc,0xd5,0xec,0x5b,0x9e,0x2c,0xad,0xb1,0x48,0x16,0x01,0xe1,0x69,0x84,0x2e,0x07,0x63,0xe9,
+    0x87,0x9b,0x67,0x1a,0xaa,0xf0,0x93,0x4d,0x89,0x9c,0x8d,0xa6,0xbe,0x52,0x94,0x1b,0x1a,0x24,0x34,0xc1,
+    0x3b,0x8c,0x36,0x0a,0xdf,0xc3,0x32,0xf8,0x3c,0x2c,0x19,0xd4,0x8c,0x71,0xd8,0x49,0x29,0x01,0x8c,0x32,
+    0x57,0x30,0x94,0x70,0x40,0x24,0x85,0x6a,0x5a,0x5d,0xae,0xdc,0x69,0x8d,0xa3,0x19,0xae,0xd5,0x33,0x4f,
+    0xe3,0x66,0x73,0x30,0xa5,0xe7,0x00,0x8b,0xba,0x48,0xef,0x70,0xdc,0x85,0xac,0x48,0x99,0x09,0xc3,0x38,
+    0xa9,0x6d,0x3b,0x7d,0x74,0x74,0xd0,0x5b,0x6e,0x76,0x77,0xa8,0x70,0x3a,0xfd,0x7e,0xb7,0x9f,0xcb,0x30,
+    0x5c,0x47,0x54,0xe0,0x77,0x7b,0xe5,0x79,0xd8,0xdb,0x71,0xda,0xef,0x3b,0xdd,0x6e,0xe9,0x00,0x85,0xb0,
+    0x26,0xf5,0x18,0xc2,0xe0,0x08,0x77,0x0e,0x96,0x95,0xed,0x1d,0x4a,0x70,0xbf,0x77,0x6c,0xfb,0xb9,0x50,
+    0x3a,0x63,0x69,0x54,0xd7,0x71,0x18,0x1e,0x38,0x7e,0xa7,0xba,0xbd,0x43,0x47,0xef,0xb8,0xdb,0x3b,0x46,
+    0xe0,0x08,0x49,0x42,0x2a,0x7b,0xb2,0x6e,0xe1,0x28,0xec,0x56,0xba,0xa3,0x68,0x85,0x1f,0x01,0x1a,0x55,
+    0x41,0xdb,0x3a,0xc6,0xb1,0x84,0x1e,0x16,0x02,0x8e,0xf3,0x35,0x72,0x26,0x8c,0x04,0xee,0x04,0xa5,0x45,
+    0x33,0xd7,0xe1,0x5d,0x48,0xb7,0x18,0x9d,0xaf,0x0f,0x84,0x11,0xbe,0x70,0xbf,0x98,0x71,0x41,0xc2,0xcb,
+    0x56,0x41,0x58,0x03,0x9e,0x22,0x20,0xaa,0x31,0x16,0x73,0xa8,0x90,0x8b,0x22,0x32,0x49,0x5a,0x04,0xda,
+    0x8d,0x0f,0x7c,0xac,0xe0,0x52,0xc7,0x7a,0x35,0xbb,0xfd,0xf0,0x38,0x44,0x5b,0x91,0x1c,0xe6,0xed,0x4a,
+    0x27,0x13,0xc8,0x63,0x4a,0x0b,0x9c,0x31,0x1c,0x21,0x41,0xce,0x71,0x81,0xf3,0x9e,0x54,0x55,0x30,0x8f,
+    0x73,0xb8,0xa5,0xd6,0xf7,0xfd,0x6d,0xee,0xe8,0x82,0xc8,0x43,0x20,0xce,0x4d,0x5a,0x74,0x27,0x06,0x4b,
+    0x8f,0x06,0x03,0x14,0xc2,0xe9,0x45,0x19,0xbc,0xae,0xbb,0x6b,0x1f,0xd1,0x98,0xd3,0x68,0x26,0x4a,0x1f,
+    0x1d,0xa7,0xe2,0xa3,0xb3,0x1d,0x3a,0x94,0xb3,0xee,0x63,0x0f,0x3a,0x57,0xd0,0x74,0x20,0x25,0x23,0x1c,
+    0x0a,0xf5,0xb0,0xed,0x64,0x63,0xe3,0x65,0xe9,0x49,0x2e,0x2b,0xb3,0xf6,0xb3,0x18,0x07,0x04,0x19,0x1b,
+    0xde,0x3d,0xe8,0x43,0x9a,0xcc,0x45,0x4e,0xb5,0xeb,0x2a,0x48,0x3e,0xdc,0xa6,0x43,0x47,0x12,0xe0,0x72,
+    0x39,0x6c,0xe7,0xa3,0x63,0xd8,0x56,0xe3,0xab,0x31,0x94,0x83,0x61,0x34,0x0c,0xc8,0xb9,0x06,0x84,0xc9,
+    0xb9,0xd7,0x5c,0xd3,0x7b,0xb3,0xbe,0x0c,0x16,0xe4,0xd0,0x73,0x34,0xa5,0xc0,0x6b,0x0a,0x7c,0x21,0x5a,
+    0x0a,0x0b,0x25,0x0a,0x0a,0x72,0x81,0x76,0xdb,0x41,0xd0,0xcd,0x51,0xf6,0xf6,0xdd,0xab,0xec,0x6d,0x76,
+    0xb3,0x7a,0xae,0xad,0xfe,0x93,0x5d,0xc3,0xcb,0x37,0x5a,0xf6,0x7a,0xf5,0x3c,0xbb,0x06,0x67,0x1c,0x39,
+    0xd4,0x70,0x84,0x7d,0xa1,0x91,0xc0,0x6b,0x72,0x9c,0x40,0x25,0x9b,0x1a,0x4d,0x60,0xb4,0x42,0x4f,0x7a,
+    0xcd,0x94,0xf8,0xcf,0x0c,0xb3,0x59,0x5a,0x2f,0xf1,0xaa,0x88,0x6e,0x07,0x33,0x6e,0xba,0xa5,0xca,0xce,
+    0xb7,0x81,0x08,0x21,0xb5,0x73,0xbb,0xe0,0x40,0x35,0x5c,0x49,0xb9,0x4d,0xe5,0x4b,0xfe,0x38,0x6a,0xb5,
+    0x06,0xea,0x7b,0xd8,0x06,0xb1,0x5a,0x6a,0x64,0xa6,0x41,0x0f,0x74,0x49,0xa2,0x0e,0x08,0x29,0x0c,0x6a,
+    0xe1,0x7d,0xf4,0xdf,0xbf,0x3f,0xae,0x1c,0x50,0xa1,0xc1,0x78,0x68,0x96,0x47,0xf3,0x59,0x21,0x9d,0x90,
+    0x32,0x35,0x0f,0x4a,0x9a,0x80,0xc4,0xbd,0xce,0xae,0x21,0x51,0x2f,0xb5,0xd5,0xcb,0xec,0x7a,0xa0,0xc1,
+    0xf0,0x67,0x34,0x99,0x28,0x65,0x11,0x9d,0x3c,0x06,0xb8,0x81,0x45,0x5b,0x56,0x56,0xae,0x8f,0xb4,0x2b,
+    0x2d,0xfb,0x6b,0xf6,0xf5,0xea,0xf9,0x2d,0xd1,0x53,0x00,0x42,0x4d,0xf2,0x57,0x1f,0xee,0x30,0x5c,0x92,
+    0x48,0xbd,0xfe,0x15,0xb2,0x28,0x62,0x1d,0x65,0xff,0x94,0x9e,0xbd,0x7b,0x25,0xfd,0xfa,0x46,0x39,0xf9,
+    0x46,0x5b,0xfd,0x21,0xfb,0x73,0x11,0x7a,0x2d,0x45,0x0a,0xd3,0x79,0x3e,0xb9,0xec,0x8f,0xb3,0x62,0x01,
+    0x0a,0x1c,0x41,0x65,0x4b,0x89,0x53,0xb9,0x07,0x65,0x2e,0x12,0x52,0xfd,0x04,0xa8,0xce,0xa0,0x90,0x49,
+    0xa9,0x12,0xc8,0x56,0xdb,0x10,0xee,0x2d,0x4d,0x1f,0xe5,0x00,0x91,0xba,0xfe,0xf7,0xd5,0x1f,0xbf,0xd4,
+    0xb2,0x9b,0xec,0xdf,0xef,0x5e,0x01,0xe8,0xc0,0xc7,0x17,0x12,0x74,0x12,0x7f,0x3f,0xbc,0x86,0x57,0x23,
+    0x07,0x61,0x1b,0xb0,0x79,0x9d,0x7d,0x9f,0xdd,0x98,0xc3,0x76,0x6e,0xe9,0x4e,0x93,0x72,0xd6,0x55,0x0c,
+    0x02,0x3e,0x90,0x6c,0x60,0x6b,0xca,0x70,0xe8,0xe9,0xed,0x88,0xc4,0x44,0xf0,0x0f,0xb8,0xa7,0xef,0x9d,
+    0x42,0xf5,0x6e,0x56,0x2f,0xb2,0xef,0xde,0xbd,0x02,0xd8,0x97,0x68,0x7f,0x40,0xbd,0x1a,0x84,0xf7,0xe8,
+    0x9f,0x12,0x0e,0x97,0xc1,0xcb,0xd2,0x80,0x0c,0x07,0xd2,0xae,0xf2,0xff,0xa0,0xee,0x7c,0xc4,0xdd,0xa3,
+    0x1c,0xea,0xfc,0x54,0x90,0x18,0xeb,0x75,0xcf,0x8b,0xdc,0x3c,0xa8,0x1f,0x86,0x70,0x45,0xb9,0x1f,0x61,
+    0xc4,0x4e,0xe8,0x44,0x56,0x41,0xf6,0xfc,0x0f,0x7f,0x51,0x8a,0xfe,0x01,0x98,0x01,0x88,0x5e,0xaf,0x7e,
+    0x9f,0x7d,0xb7,0x7a,0xb9,0xd6,0x59,0xaf,0x36,0xf7,0x19,0x49,0xa1,0x2b,0x23,0x2c,0xb4,0x53,0x2f,0xc1,
+    0x73,0xed,0xf3,0xdf,0x9c,0x9c,0x82,0x3e,0x7f,0xfa,0x19,0x62,0x28,0xe6,0xc6,0xda,0x75,0xae,0x56,0x4d,
+    0x6b,0x82,0x85,0xa1,0x73,0xdd,0xbc,0xba,0xb2,0xdd,0x46,0x38,0x4b,0x7c,0xb9,0xab,0xe5,0xcc,0xb1,0x38,
+    0xf5,0x02,0xea,0xcf,0x62,0xa0,0x2a,0x29,0xf7,0x24,0xc2,0xf2,0xf1,0xc3,0xcb,0x8f,0x03,0x38,0xa2,0xd8,
+    0x46,0x37,0xad,0x73,0x04,0x95,0x75,0x23,0xc8,0x2f,0x4e,0x0c,0xd3,0x9d,0xa5,0x01,0x12,0xd8,0x30,0x97,
+    0x1b,0x65,0xb9,0x28,0x37,0x12,0x53,0x0e,0x08,0x2e,0x34,0xfc,0xb0,0x5a,0x97,0x84,0x46,0x32,0x74,0xae,
+    0xae,0x80,0xd4,0x53,0xa9,0x85,0x5b,0x11,0x4e,0x26,0xf0,0x27,0x80,0x97,0x98,0x0c,0x8b,0x19,0x4b,0x5c,
+    0x0c,0xd7,0x02,0xe0,0xdc,0x5f,0x9c,0x7d,0x72,0xe2,0xc1,0xc4,0x69,0x84,0x94,0x19,0x32,0x72,0xe2,0xd9,
+    0x2e,0x19,0x26,0x2e,0xd9,0xdb,0x2b,0x2d,0xd2,0x8d,0x45,0x9f,0x61,0x70,0xb0,0x30,0x6a,0xe8,0xb9,0x76,
+    0x30,0x48,0xf3,0x48,0x3c,0x02,0x4f,0x92,0xa7,0x3d,0x3d,0x7b,0x0b,0xb5,0x7c,0x0b,0x30,0x79,0xa3,0xe9,
+    0x7b,0x06,0xd9,0x83,0x4b,0x34,0xb6,0x80,0x2b,0x0d,0x6a,0x2e,0x71,0x21,0x7d,0x0a,0x4b,0x8a,0x5e,0xad,
+    0x82,0x5d,0x3d,0x5d,0xdd,0x3c,0xf5,0x6a,0xfc,0x53,0x3a,0x37,0x02,0x73,0x51,0xe6,0x21,0xb0,0x8a,0x27,
+    0xd3,0xbd,0x33,0x0f,0x02,0x32,0xab,0xa2,0x3b,0x93,0xae,0x04,0x6a,0x32,0xb9,0x8d,0x3b,0xc5,0x15,0xdf,
+    0x6e,0x1d,0x51,0x6b,0x27,0x94,0x8b,0x0f,0xf4,0xc7,0xf2,0x51,0x4b,0xa8,0x80,0x5a,0x08,0x7d,0x00,0xea,
+    0x00,0xad,0x77,0x1b,0x2f,0x19,0x72,0x4b,0x61,0xb9,0x7c,0x8f,0x1f,0x05,0x61,0xde,0x3e,0x28,0x57,0xdd,
+    0xbc,0x16,0x5c,0xdc,0x53,0x7e,0xe0,0x76,0xa8,0x45,0xa3,0x90,0x4c,0x82,0x7b,0x44,0x37,0x94,0x98,0xc3,
+    0x25,0xb0,0xe6,0x78,0xac,0xc8,0x10,0x52,0x9d,0xc8,0xf8,0xa1,0xcb,0x4e,0x00,0x97,0xaa,0x66,0xba,0x2c,
+    0xf2,0x12,0x47,0x1c,0x6f,0x6d,0x32,0x1c,0xc3,0xbd,0xb3,0xd8,0x6f,0x28,0x3d,0x32,0xd9,0x43,0xf0,0x5b,
+    0x91,0x0a,0x28,0x13,0x55,0xa0,0x01,0x1e,0xfe,0x95,0x7d,0x0f,0x4c,0x78,0x03,0xa4,0x98,0xbd,0x91,0xec,
+    0xb4,0xfa,0x52,0x77,0x41,0x28,0xc7,0xc1,0xe6,0x3e,0xe3,0xe9,0x8f,0x82,0x03,0x1c,0x04,0xa8,0xb2,0xab,
+    0xe6,0x3d,0x6c,0x74,0x7a,0xbd,0x23,0xe7,0x00,0x50,0x22,0x3d,0xd2,0x6a,0x56,0x2f,0x71,0x14,0xd1,0xf9,
+    0x2d,0xb3,0xeb,0x79,0x71,0x97,0x2d,0xb8,0x3c,0x75,0xfd,0x60,0x87,0xad,0x7e,0xef,0xf0,0xc0,0x2e,0x6d,
+    0x6d,0xa9,0xcd,0xfe,0x96,0x7d,0x7b,0x8f,0xca,0x7e,0x70,0xb4,0xd3,0xfd,0x23,0xa7,0xe3,0x4b,0xf7,0x2b,
+    0x28,0x2f,0x1b,0x7f,0x11,0x62,0xe1,0x4f,0x0d,0x60,0x45,0x35,0xa7,0x73,0xc6,0x35,0x2d,0x31,0x05,0x7a,
+    0x60,0xde,0x88,0x59,0x5f,0x70,0x0a,0x44,0x51,0xac,0xc8,0xde,0x30,0xe1,0x2a,0x26,0x8f,0x60,0x6f,0x24,
+    0xeb,0x4e,0xc1,0x0e,0x20,0xc6,0xc0,0x26,0xd4,0x43,0xf6,0x33,0xe6,0xfb,0x29,0x8d,0x22,0x77,0x6d,0xaa,
+    0x24,0x9b,0x05,0xe4,0x0d,0x73,0x13,0x73,0x89,0x75,0x0e,0xb6,0x5d,0xcc,0x15,0xeb,0x3d,0x39,0x07,0x98,
+    0x00,0x14,0x98,0x0f,0x85,0x6d,0x63,0xf9,0x56,0x3a,0x02,0x22,0x70,0x4d,0x8c,0x31,0xe7,0x08,0xae,0x48,
+    0x60,0x52,0x75,0xe7,0x2f,0x4f,0x3f,0xfd,0xb5,0x95,0xca,0x7f,0x48,0x18,0xd0,0xc9,0x48,0x20,0x13,0x40,
+    0xa8,0x24,0x31,0x63,0x10,0xb1,0x61,0x7a,0xa3,0xdc,0x1a,0xe0,0x05,0x05,0x97,0xa7,0x10,0x1b,0xf6,0x3c,
+    0xe7,0xfd,0xf7,0xdf,0x93,0xae,0x99,0xf2,0xc3,0x83,0xde,0xfa,0x58,0x5e,0xea,0x80,0x19,0x8c,0x3c,0x1b,
+    0xfb,0x3d,0xdb,0xb6,0xcd,0x6a,0x96,0x6a,0x23,0x7b,0x9d,0xaa,0x7c,0xf5,0xa9,0x82,0xb4,0x5e,0x64,0x46,
+    0x9a,0x2c,0x73,0x6a,0xde,0xd2,0xb0,0x1e,0xd5,0xdb,0x3a,0x24,0x0d,0xe9,0x55,0xf9,0xcd,0x3c,0x91,0x01,
+    0x40,0x82,0x43,0xc2,0x62,0x43,0x07,0xdc,0x7e,0x0b,0x3f,0x7f,0x5a,0xbd,0x90,0x57,0x11,0xb8,0x62,0x02,
+    0xa2,0x5f,0x67,0x5f,0xe9,0xe6,0x46,0xa3,0x3a,0xf9,0x14,0x4a,0x51,0x75,0x69,0x81,0x22,0xcc,0x80,0x37,
+    0x01,0xf5,0x2f,0xb2,0xaf,0xe1,0x13,0x06,0x1d,0x00,0x53,0xaf,0x30,0xbf,0x0c,0xf8,0xd6,0x3c,0x70,0x1b,
+    0x70,0xc5,0xc9,0xc7,0x13,0x0c,0x2f,0x75,0x81,0x6e,0xab,0x7f,0x17,0xfd,0x1f,0xce,0xb3,0xb1,0xbe,0x3e,
+    0x12,0x00,0x00,
+};
+const size_t INDEX_HTML_GZ_LEN = 2063;
+const char INDEX_HTML_ETAG[] = "\"19c7c9f0975b69c4\"";
+
+// LIMITS_HTML: 2365 bytes -> 1159 bytes gzipped
+const uint8_t LIMITS_HTML_GZ[] PROGMEM = {
+    0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x8d,0x56,0xdd,0x8e,0xdb,0x44,0x14,0xbe,0xcf,0x53,
+    0x0c,0xae,0x20,0x31,0xdb,0x38,0x7f,0xcd,0x6e,0xe4,0x9f,0x20,0xd1,0x1f,0x81,0x54,0x44,0x45,0xb7,0x17,
+    0x5c,0xa1,0xb1,0x67,0x6c,0x0f,0x1d,0xcf,0x84,0xf1,0x38,0xbb,0x21,0xcd,0x05,0x88,0x05,0x2e,0xf6,0x3d,
+    0x5a,0x55,0xa2,0xcb,0x16,0x24,0xe0,0x4d,0x1c,0xfa,0x32,0x9c,0xb1,0x9d,0x6c,0xb2,0x6c,0xa5,0xd5,0x6a,
+    0x65,0xcf,0x99,0x73,0xbe,0xf3,0x9d,0x73,0xbe,0x19,0xc7,0xff,0xe0,0xc1,0x97,0xf7,0x8f,0xbf,0x7e,0xf2,
+    0x10,0xa5,0x3a,0xe3,0xd3,0x96,0x6f,0x1e,0x88,0x63,0x91,0x04,0x56,0x8c,0x2d,0x44,0x98,0x0a,0x2c,0xa5,
+    0xb9,0x35,0xf5,0x53,0x8a,0xc9,0xd4,0xcf,0xa8,0xc6,0x28,0x4a,0xb1,0xca,0xa9,0x0e,0xac,0x67,0xc7,0x8f,
+    0xba,0x13,0xab,0xb1,0x0a,0x9c,0xd1,0xc0,0x9a,0x33,0x7a,0x32,0x93,0x4a,0x5b,0x28,0x92,0x42,0x53,0x01,
+    0x5e,0x27,0x8c,0xe8,0x34,0x20,0x74,0xce,0x22,0xda,0xad,0x16,0x77,0x99,0x60,0x9a,0x61,0xde,0xcd,0x23,
+    0xcc,0x69,0x30,0xb0,0x20,0xb3,0x66,0x9a,0xd3,0xe9,0x63,0x96,0x31,0x8d,0xee,0x4b,0x11,0xb3,0xc4,0xef,
+    0xd5,0xb6,0x96,0x9f,0xeb,0x05,0x3c,0x3f,0x5e,0x66,0x58,0x25,0x4c,0xb8,0x7d,0x6f,0x86,0x09,0x61,0x22,
+    0x81,0xb7,0x50,0x9e,0x76,0x73,0xf6,0xbd,0x59,0x84,0x52,0x11,0xaa,0xba,0x60,0x59,0x85,0x92,0x2c,0x96,
+    0x31,0x10,0xe8,0xc6,0x38,0x63,0x7c,0xe1,0x6a,0x9c,0xca,0x0c,0x7b,0x21,0x8e,0x9e,0x27,0x4a,0x16,0x82,
+    0xb8,0x77,0xe2,0x7e,0x3c,0x8c,0xc7,0x5b,0xa8,0x41,0x7f,0x76,0xba,0x6a,0x39,0x86,0x35,0x66,0x82,0x2a,
+    0x48,0x76,0x5a,0xb3,0x75,0xc7,0x7d,0xd8,0xf3,0x36,0xc9,0x11,0x2e,0xb4,0x5c,0x39,0x11,0x56,0x64,0xb9,
+    0x87,0x17,0xc7,0x5b,0xb0,0xa1,0x09,0x68,0xf8,0x28,0x4c,0x58,0x91,0xbb,0x83,0x61,0x65,0x02,0xb6,0x29,
+    0x26,0xf2,0x04,0x70,0xc0,0x80,0x26,0xf0,0xaf,0x92,0x10,0x77,0xfa,0x77,0xab,0x3f,0x67,0x60,0xaf,0x5a,
+    0xe9,0x68,0x19,0x49,0x2e,0x95,0x7b,0x67,0x34,0x1a,0x35,0x79,0xa1,0x2c,0xad,0x65,0x56,0x23,0x6b,0x7a,
+    0xaa,0xbb,0x98,0xb3,0x44,0xb8,0x11,0xb4,0x98,0xaa,0x95,0x13,0x4b,0x95,0x75,0x0d,0x95,0xd9,0xa6,0x4b,
+    0x83,0x31,0x60,0xf7,0x57,0x1c,0x87,0x94,0x2f,0x09,0xcb,0x67,0x1c,0x2f,0xdc,0x90,0xcb,0xe8,0xf9,0x35,
+    0x48,0xf0,0xf3,0x9a,0x7c,0xe3,0xf1,0xd8,0xab,0xda,0x76,0x42,0x59,0x92,0x6a,0x68,0x29,0x27,0xab,0x16,
+    0x13,0xb3,0x42,0x2f,0xeb,0x5e,0x0c,0xfa,0xfd,0x0f,0xf7,0x7a,0xd6,0x94,0xe9,0x9a,0x6a,0x72,0xc9,0x19,
+    0x41,0x77,0x08,0x21,0xd7,0x8a,0x3f,0x04,0xbf,0x0a,0x17,0x46,0x45,0xdd,0x01,0xcd,0x56,0x15,0xa6,0x1b,
+    0xcb,0xa8,0xc8,0x97,0xb2,0xd0,0x1c,0x5a,0xee,0x0a,0x29,0xe8,0x26,0xb0,0x21,0xd4,0xef,0x1f,0x85,0x71,
+    0x0c,0x73,0x09,0xb5,0xb8,0x91,0xc1,0xf0,0x6a,0x32,0x86,0x0d,0xea,0x6f,0xf8,0xec,0x82,0x35,0x2c,0x26,
+    0xd7,0x59,0x78,0x51,0xa1,0x72,0x48,0x33,0x93,0xcc,0x74,0x71,0xd3,0x05,0x33,0x49,0xad,0xb0,0xc8,0x41,
+    0xa4,0x12,0x26,0xee,0x8c,0xf2,0x9a,0x41,0x37,0xc7,0x73,0xba,0x37,0xf4,0xe1,0x04,0x1f,0xdd,0x1b,0xaf,
+    0xb6,0x9b,0x6e,0x2a,0xe7,0xa0,0x9d,0x3d,0x97,0xc1,0x64,0x32,0x9a,0xd4,0x2e,0xc6,0xbe,0xb7,0x79,0x18,
+    0x1d,0x8d,0x8f,0xc8,0xd5,0xe6,0x0d,0xf1,0xe3,0x7b,0xe3,0xf0,0x70,0x68,0xa4,0x59,0x28,0x05,0xd3,0xde,
+    0xdb,0xa4,0x47,0xf1,0x68,0x47,0x77,0x83,0xff,0xeb,0xee,0x70,0xdb,0xa0,0xcd,0xbc,0x8d,0x30,0x6e,0x90,
+    0x90,0xdf,0xab,0x8f,0x99,0xdf,0xab,0x8e,0x7a,0xcb,0x37,0x87,0x68,0xea,0x13,0x36,0x47,0x11,0xc7,0x79,
+    0x1e,0x58,0xdb,0xb3,0x61,0xed,0x9b,0xe1,0x24,0x98,0x0b,0x62,0x34,0x2d,0x5f,0xaf,0x7f,0x2e,0xff,0x7e,
+    0x77,0xbe,0x3e,0x43,0xe5,0x6f,0xe5,0xc5,0xfa,0xd7,0xf2,0x02,0xc1,0xe3,0xac,0x7c,0x09,0xa0,0x23,0x80,
+    0xdc,0x8d,0xaa,0xab,0xb1,0x10,0x23,0x57,0x8b,0xa9,0xe3,0x38,0x7e,0x0f,0xbc,0xc0,0xd7,0x28,0x1a,0x49,
+    0x91,0x17,0x21,0x5c,0x09,0x81,0x65,0xba,0xdb,0xa1,0x73,0xf0,0xb2,0xf7,0xd3,0x5f,0x29,0x1f,0xec,0x95,
+    0xda,0xa7,0x26,0x39,0x2a,0xff,0x28,0x5f,0x95,0x6f,0x5d,0xbf,0x57,0xdb,0x5a,0x7e,0x25,0x39,0xa4,0x17,
+    0x33,0xb8,0xa6,0x44,0x91,0x85,0x50,0x07,0xca,0x35,0x9d,0x05,0x16,0x1c,0xbb,0x9a,0x47,0xa2,0x28,0x15,
+    0x16,0x52,0xf4,0xbb,0x82,0x29,0x0a,0xf7,0x5d,0xc3,0xe5,0x36,0xe9,0xde,0x96,0x97,0xe5,0xc5,0x36,0xdd,
+    0x6d,0xb2,0x2d,0x28,0xe7,0xf2,0xe4,0x86,0x74,0x61,0x01,0x83,0x12,0x4d,0x70,0xdd,0x00,0x6b,0x93,0x1f,
+    0x94,0x82,0x36,0x6a,0xb3,0xa6,0xe5,0xef,0xe5,0x9b,0x77,0xe7,0xe5,0xe5,0xfa,0x17,0xbf,0x57,0x47,0x01,
+    0x88,0xa1,0x78,0x85,0x72,0x2d,0xce,0xa8,0xc7,0x82,0xbe,0x46,0x9c,0x45,0xcf,0x03,0x0b,0xee,0x03,0x6c,
+    0x54,0xee,0xa4,0x8a,0xc6,0x41,0xbb,0xf7,0x49,0x1e,0xb4,0x0f,0x9e,0x02,0xf0,0xab,0xf2,0x65,0xf9,0xf6,
+    0xdf,0x8b,0xf2,0xcf,0xf2,0xf5,0x0e,0xb4,0xe1,0xb7,0x61,0x99,0x47,0x8a,0xcd,0xf4,0xb4,0x05,0xb2,0xc8,
+    0x35,0x7a,0x1a,0x08,0x7a,0x82,0x9e,0x7d,0xf5,0xf8,0x29,0xc5,0x2a,0x4a,0x9f,0x60,0x85,0xb3,0xbc,0xb3,
+    0x85,0xcf,0x2b,0xab,0xed,0x24,0x54,0x77,0xda,0x79,0xdb,0x7e,0xf1,0xa2,0xef,0xb5,0x62,0xaa,0xa3,0xb4,
+    0xd3,0xee,0x81,0xf1,0x1b,0x6e,0x6e,0xfe,0xbc,0x4e,0x6f,0x3b,0x3a,0xa5,0xa2,0xa3,0x82,0xa9,0x72,0xbe,
+    0xcd,0xa5,0xe8,0xd8,0x8d,0x85,0x04,0xd3,0x25,0x81,0x3b,0x23,0x03,0x19,0x18,0xa8,0x87,0x9c,0x9a,0xd7,
+    0x4f,0x17,0x9f,0x93,0x4e,0xbb,0x1a,0x5e,0xdb,0x76,0xe6,0x98,0x17,0x34,0x20,0x4e,0xb5,0xf6,0x5a,0xef,
+    0xf5,0xaf,0xdb,0xbf,0x13,0x50,0x1b,0xbc,0xf7,0x06,0x34,0x2a,0x85,0x08,0x26,0xe0,0x14,0x7c,0x76,0xfc,
+    0xc5,0xe3,0xa0,0xd5,0x5e,0xff,0x50,0xfe,0xb3,0xfe,0xe9,0xdd,0xb9,0xdb,0x28,0x0e,0xb5,0x0f,0x9a,0xdc,
+    0x07,0x6d,0xf4,0xa2,0xd1,0x45,0x65,0xac,0xf1,0x57,0x36,0x14,0x5e,0x88,0xc8,0xb4,0x05,0xd5,0xaa,0xb6,
+    0x97,0xd4,0x99,0xa9,0x4a,0xdc,0x0f,0x68,0x8c,0x0b,0xae,0x3b,0xb6,0x57,0xb7,0x35,0x09,0x6e,0x57,0xaf,
+    0xd7,0x8c,0x61,0x11,0xdc,0xb2,0x5e,0x8f,0xc5,0x9d,0x99,0xf9,0x8e,0x3f,0xe2,0x12,0xeb,0xce,0xc2,0xf6,
+    0x83,0x9d,0x65,0x62,0xdb,0x4b,0xf8,0x34,0x2b,0x18,0x56,0xf9,0xa6,0xfc,0xab,0x7c,0x09,0xe7,0xb8,0xbc,
+    0x44,0xeb,0xb3,0xf5,0x8f,0xa0,0x8b,0x0b,0x23,0xb9,0xb6,0xed,0x29,0xaa,0x0b,0x25,0x56,0xdb,0x39,0x9a,
+    0x6a,0xf6,0x06,0x79,0xd0,0xfe,0xa8,0x62,0x09,0xef,0x09,0xbc,0xd7,0x0c,0x60,0xb1,0x68,0xe6,0xd9,0xb1,
+    0x61,0xa0,0x9b,0x3c,0x5b,0x29,0x23,0x10,0xdd,0x05,0xc0,0xdf,0xac,0xcd,0x15,0x7c,0x21,0xe1,0xae,0xaa,
+    0xc5,0x07,0xd2,0xac,0x6e,0xa9,0x5e,0xf5,0xfb,0xe5,0x3f,0xe6,0x66,0x0d,0xb7,0xcf,0x08,0x00,0x00,
+};
+const size_t LIMITS_HTML_GZ_LEN = 1159;
+const char LIMITS_HTML_ETAG[] = "\"447b1363448108f4\"";
+
+// SET_TIME_HTML: 1944 bytes -> 1028 bytes gzipped
+const uint8_t SET_TIME_HTML_GZ[] PROGMEM = {
+    0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x85,0x55,0xcb,0x8e,0xdb,0x36,0x14,0xdd,0xeb,0x2b,
+    0x18,0x0d,0x1a,0x4b,0xcd,0x48,0x96,0xed,0x78,0xc6,0x90,0x25,0x2d,0x9a,0x4c,0x81,0x74,0xd1,0x14,0x98,
+    0xe9,0xa2,0xab,0x82,0x16,0x29,0x89,0x8d,0x44,0xba,0x24,0x65,0x8f,0x6b,0x78,0xd9,0x66,0x93,0xff,0x48,
+    0x31,0x8b,0xa6,0xaf,0x45,0xfb,0x27,0x9a,0xe6,0x67,0x7a,0x29,0xc9,0x1e,0xbb,0x4d,0x51,0x18,0xd6,0xe3,
+    0x92,0x3c,0xf7,0xdc,0x73,0x1f,0x8a,0x1e,0x3d,0x7f,0xf9,0xec,0xe6,0xab,0x2f,0xae,0x50,0xa1,0xab,0x32,
+    0xb1,0x22,0x73,0x43,0x25,0xe6,0x79,0x6c,0x67,0xd8,0x46,0x84,0xc9,0xd8,0x96,0xba,0xb4,0x93,0xa8,0xa0,
+    0x98,0x24,0x51,0x45,0x35,0x46,0x69,0x81,0xa5,0xa2,0x3a,0xb6,0xbf,0xbc,0xf9,0xd4,0x9b,0xd9,0xbd,0x95,
+    0xe3,0x8a,0xc6,0xf6,0x8a,0xd1,0xf5,0x52,0x48,0x6d,0xa3,0x54,0x70,0x4d,0x39,0xec,0x5a,0x33,0xa2,0x8b,
+    0x98,0xd0,0x15,0x4b,0xa9,0xd7,0xbe,0x9c,0x33,0xce,0x34,0xc3,0xa5,0xa7,0x52,0x5c,0xd2,0x78,0x64,0x83,
+    0x67,0xcd,0x74,0x49,0x93,0x1b,0x56,0x51,0xf4,0x4c,0xf0,0x8c,0xe5,0xd1,0xb0,0x33,0x59,0x91,0xd2,0x1b,
+    0xb8,0x7f,0xbc,0xad,0xb0,0xcc,0x19,0x0f,0x83,0xf9,0x12,0x13,0xc2,0x78,0x0e,0x4f,0x0b,0x71,0xeb,0x29,
+    0xf6,0x9d,0x79,0x59,0x08,0x49,0xa8,0xf4,0xc0,0xb2,0x5b,0x08,0xb2,0xd9,0x66,0xe0,0xdf,0xcb,0x70,0xc5,
+    0xca,0x4d,0xa8,0x71,0x21,0x2a,0x3c,0x5f,0xe0,0xf4,0x55,0x2e,0x45,0xcd,0x49,0x78,0x96,0x05,0xd9,0x38,
+    0x9b,0x1e,0xa0,0x46,0xc1,0xf2,0x76,0x67,0xf9,0x86,0x34,0x66,0x9c,0x4a,0x70,0x76,0xdb,0x91,0x0d,0xa7,
+    0x01,0xac,0xcd,0xf7,0xce,0x11,0xae,0xb5,0xd8,0xf9,0x29,0x96,0x64,0x7b,0x82,0x97,0x65,0x07,0xb0,0xb1,
+    0x39,0xd0,0xf3,0x91,0x98,0xb0,0x5a,0x85,0xa3,0x71,0x6b,0x02,0xb6,0x05,0x26,0x62,0x0d,0x38,0x60,0x40,
+    0x33,0xf8,0xcb,0x7c,0x81,0x9d,0xe0,0xbc,0xfd,0xf9,0x23,0x77,0x67,0x15,0x93,0x6d,0x2a,0x4a,0x21,0xc3,
+    0xb3,0xc9,0x64,0xd2,0xfb,0x85,0xb0,0xb4,0x16,0x55,0x87,0xac,0xe9,0xad,0xf6,0x70,0xc9,0x72,0x1e,0xa6,
+    0xa0,0x30,0x95,0x40,0xa7,0x96,0x12,0x1e,0x3d,0x0d,0xfa,0x9d,0xd0,0xa2,0x97,0xd9,0xe4,0x88,0xd9,0x68,
+    0xfa,0x2f,0x66,0xb3,0x43,0x70,0xff,0xe3,0xc4,0xf2,0x0d,0xba,0x47,0x98,0x5a,0x96,0xb8,0xd7,0x17,0xb4,
+    0xa7,0xe1,0xc8,0x9f,0xd2,0x6a,0xde,0xbe,0xaf,0x29,0xcb,0x0b,0x0d,0xb9,0x28,0xc9,0xbc,0x0f,0x22,0x08,
+    0x2e,0x17,0xc0,0xa0,0xd7,0xcf,0xe8,0x8c,0x82,0x1d,0xe3,0xcb,0x5a,0x6f,0x3b,0x7d,0x47,0x41,0xf0,0xd1,
+    0x03,0xc1,0xf1,0x81,0x60,0x68,0x14,0x52,0xa2,0x64,0x04,0x9d,0x11,0x42,0xe6,0xd6,0x29,0xef,0x0b,0xd8,
+    0x78,0xc4,0x01,0x18,0x7c,0xc0,0x45,0x98,0x89,0xb4,0x56,0x5b,0x51,0xeb,0x12,0xb2,0x1a,0x72,0xc1,0xe9,
+    0x3e,0xfc,0x13,0x7a,0x3b,0x7f,0xa1,0xf9,0x7f,0xf2,0xb1,0x7a,0x64,0x93,0xae,0x60,0xcf,0xee,0x18,0xeb,
+    0x48,0xca,0x53,0x4a,0x90,0x17,0x05,0x5e,0x96,0x82,0x19,0x09,0xf7,0x92,0x98,0x5a,0xd1,0x12,0x73,0x05,
+    0x5d,0x20,0xa0,0xa6,0xfc,0x89,0x6a,0x09,0x78,0x0a,0xaf,0x4e,0xd3,0x37,0x9e,0xe1,0xcb,0xa7,0x53,0x90,
+    0x7e,0xbf,0x1a,0x16,0x62,0x05,0xd5,0x79,0xb2,0x67,0x34,0x9b,0x4d,0x66,0x1d,0x80,0xb1,0x9f,0x2c,0x5e,
+    0xa4,0x97,0xd3,0x4b,0xf2,0xb0,0xf8,0x81,0xf3,0xd3,0xa7,0xd3,0xc5,0xc5,0x78,0x17,0x0d,0xbb,0x3e,0x8b,
+    0x86,0x6d,0xab,0x5b,0x91,0xe9,0xa2,0x24,0x22,0x6c,0x85,0xd2,0x12,0x2b,0x15,0xdb,0x87,0xe6,0xb0,0x4f,
+    0xcd,0xd0,0x0a,0x66,0x40,0x4c,0x92,0xe6,0xee,0xfe,0x87,0xe6,0x8f,0xf7,0x6f,0xee,0xbf,0x47,0xcd,0x6f,
+    0xcd,0xdb,0xe6,0xcf,0xe6,0x0e,0xd0,0x26,0x80,0x75,0xbc,0xfd,0xa8,0x54,0x3b,0xa0,0x64,0xbf,0x19,0x35,
+    0xef,0xe0,0xf1,0xee,0xaf,0x77,0xcd,0xdb,0xfb,0xd7,0x61,0x34,0x34,0x6b,0xc7,0x47,0x8f,0xeb,0xcf,0x46,
+    0x8c,0x1c,0xc0,0x6e,0x5a,0x2c,0xcf,0xeb,0x8f,0xb4,0x57,0x2b,0xca,0x84,0xac,0x10,0x4e,0x8d,0xc6,0xb1,
+    0x3d,0x34,0xea,0x7d,0xdd,0x3b,0x6d,0x6b,0x03,0xe9,0xcd,0x12,0x26,0x16,0xc1,0x9a,0xb6,0xc0,0xa5,0x80,
+    0x69,0x64,0xf7,0x73,0x8c,0xc0,0x04,0x93,0xf4,0xdb,0x9a,0x49,0xda,0x6a,0x51,0x43,0x67,0xf0,0xfe,0x84,
+    0xaa,0x17,0x15,0x33,0x13,0xae,0x63,0x05,0xd2,0xa2,0x7d,0x7a,0xec,0xa4,0xf9,0xb9,0xf9,0xe9,0xfd,0x9b,
+    0xe6,0x97,0xfb,0xd7,0xd1,0xb0,0x3b,0x05,0x7c,0x0c,0x93,0x07,0x94,0x7f,0x9c,0x33,0xb9,0xb0,0x91,0xe0,
+    0x69,0xc9,0xd2,0x57,0xb1,0x6d,0x68,0x18,0xca,0x7e,0x21,0x69,0x16,0x0f,0x86,0x03,0xc0,0xfc,0x11,0xf4,
+    0xf9,0x15,0x64,0xf9,0xdd,0x08,0x7a,0x40,0x3d,0x8e,0x55,0xa5,0x92,0x2d,0x75,0x92,0xd5,0xbc,0x8d,0x17,
+    0xa9,0x42,0xac,0x1d,0xe2,0x6e,0x09,0xd4,0x7f,0x05,0x0a,0xf9,0x39,0xd5,0x57,0x25,0x35,0x8f,0x9f,0x6c,
+    0x5e,0x10,0x67,0x70,0xa4,0xdc,0xc0,0xf5,0x19,0x87,0xb4,0xde,0x40,0xcb,0xc7,0xc4,0x37,0x82,0x3c,0x19,
+    0xa0,0xc1,0x13,0xd2,0x36,0xfc,0xce,0x3a,0x80,0xd6,0x4b,0xb3,0xe6,0xb8,0xdb,0x8c,0xea,0xb4,0x70,0x06,
+    0x50,0x31,0x58,0xd7,0x0a,0xce,0xeb,0x82,0x72,0x47,0xc6,0x89,0xf4,0xbf,0x51,0x82,0x3b,0x6e,0x6f,0x31,
+    0x2c,0x5c,0x98,0x95,0x66,0x37,0x8d,0x13,0x28,0x20,0xe8,0x67,0xea,0x97,0x22,0x77,0xa8,0x0b,0xa3,0xae,
+    0xa4,0x1a,0x2d,0x45,0x59,0xce,0xcd,0x8a,0x46,0x54,0xc5,0x9c,0xae,0xd1,0xd5,0x0a,0x88,0x5d,0x8b,0x5a,
+    0xa6,0x14,0x7c,0x50,0xf3,0x06,0x3e,0xe6,0x54,0xf9,0x82,0x57,0x54,0x29,0x9c,0xd3,0x18,0xd0,0xda,0x10,
+    0x3f,0xbb,0x7e,0xf9,0xb9,0xbf,0x34,0xdf,0x23,0x87,0x1a,0xe6,0xd8,0x75,0xe7,0x56,0xbb,0x93,0x4a,0x29,
+    0x64,0xec,0xb8,0x71,0xb2,0x65,0x99,0x03,0x26,0x09,0x65,0xbd,0xb9,0x06,0xc6,0x34,0x8e,0xc7,0x8f,0x1f,
+    0x3f,0x32,0x8e,0x5d,0x73,0x89,0xe1,0x63,0xf6,0xc2,0xf4,0xe7,0x0a,0x97,0x4e,0x17,0xe3,0x39,0x0c,0xfd,
+    0xc0,0xdd,0xcd,0xf7,0x11,0xcf,0xa1,0x3b,0x3a,0x85,0x2d,0x48,0x40,0xdb,0x18,0xc3,0xf6,0x93,0xf9,0x37,
+    0xb9,0x24,0xb2,0xef,0x42,0x07,0x00,0x00,
+};
+const size_t SET_TIME_HTML_GZ_LEN = 1028;
+const char SET_TIME_HTML_ETAG[] = "\"e98aeb0809154b5c\"";
+
+// HISTORY_HTML: 1555 bytes -> 867 bytes gzipped
+const uint8_t HISTORY_HTML_GZ[] PROGMEM = {
+    0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x75,0x54,0x4d,0x73,0xdb,0x36,0x10,0xbd,0xeb,0x57,
+    0xa0,0xf4,0xb4,0xa2,0x9a,0x88,0xa4,0xa4,0xca,0x76,0xf9,0xd5,0x4e,0x9b,0x74,0xd2,0x99,0x64,0x9a,0xa9,
+    0x9d,0x43,0x8f,0x20,0x00,0x92,0x18,0x83,0x80,0x06,0x84,0x64,0x2b,0x8c,0x6e,0x6d,0x93,0x43,0xff,0x87,
+    0xdb,0x1c,0x92,0x49,0xda,0x4b,0xff,0x09,0xed,0xfe,0x99,0x2e,0x48,0x59,0xb6,0x32,0xc9,0x68,0x24,0x0a,
+    0x8b,0xc5,0xdb,0xf7,0x1e,0x76,0x19,0x7f,0xf6,0xe0,0xa7,0xef,0x4f,0x7f,0x79,0xfa,0x10,0x95,0xa6,0x12,
+    0xe9,0x20,0xb6,0x0f,0x24,0xb0,0x2c,0x12,0x27,0xc7,0x0e,0xa2,0x5c,0x27,0x8e,0x36,0xc2,0x49,0xe3,0x92,
+    0x61,0x9a,0xc6,0x15,0x33,0x18,0x91,0x12,0xeb,0x9a,0x99,0xc4,0x79,0x76,0xfa,0xc3,0xf8,0xd8,0xd9,0x46,
+    0x25,0xae,0x58,0xe2,0xac,0x38,0x3b,0x5f,0x28,0x6d,0x1c,0x44,0x94,0x34,0x4c,0x42,0xd6,0x39,0xa7,0xa6,
+    0x4c,0x28,0x5b,0x71,0xc2,0xc6,0xdd,0xe2,0x3e,0x97,0xdc,0x70,0x2c,0xc6,0x35,0xc1,0x82,0x25,0x13,0x07,
+    0x2a,0x1b,0x6e,0x04,0x4b,0x1f,0xf1,0xda,0x28,0xbd,0x8e,0xfd,0x7e,0x39,0x88,0x6b,0xb3,0x86,0xe7,0x97,
+    0x4d,0x85,0x75,0xc1,0x65,0x18,0x44,0x0b,0x4c,0x29,0x97,0x05,0xfc,0xcb,0xd4,0xc5,0xb8,0xe6,0xcf,0xed,
+    0x22,0x53,0x9a,0x32,0x3d,0x86,0xc8,0x26,0x53,0x74,0xdd,0xe4,0x50,0x7b,0x9c,0xe3,0x8a,0x8b,0x75,0x68,
+    0x70,0xa9,0x2a,0x1c,0x65,0x98,0x9c,0x15,0x5a,0x2d,0x25,0x0d,0x0f,0xf2,0x20,0x9f,0xe6,0xf3,0x1d,0xd4,
+    0x24,0x58,0x5c,0x6c,0x06,0x9e,0x25,0x8c,0xb9,0x64,0x1a,0x8a,0x5d,0xf4,0x44,0xc3,0xaf,0x03,0xd8,0x8b,
+    0x6e,0x8a,0x23,0xbc,0x34,0x6a,0xe3,0x11,0xac,0x69,0xb3,0x87,0x97,0xe7,0xb7,0x60,0x73,0x38,0xb0,0xe5,
+    0xa3,0x31,0xe5,0xcb,0x3a,0x9c,0x4c,0xbb,0x10,0xb0,0x2d,0x31,0x55,0xe7,0x80,0x03,0x01,0x74,0x0c,0x5f,
+    0x5d,0x64,0xd8,0x0d,0xee,0x77,0x1f,0x6f,0x32,0x8a,0x06,0x7d,0x25,0x10,0x62,0x8c,0xaa,0x3a,0xac,0x4d,
+    0x39,0x6b,0x88,0x12,0x4a,0x87,0x07,0xb3,0xd9,0x2c,0x32,0xec,0xc2,0x8c,0xb1,0xe0,0x85,0x0c,0x09,0xb8,
+    0xcb,0x74,0xf4,0x91,0x23,0x35,0x13,0x8c,0x98,0xa6,0x97,0x30,0x09,0x82,0xcf,0xf7,0xa4,0x6e,0xd9,0x85,
+    0x96,0x44,0xad,0x04,0xa7,0xe8,0x80,0x52,0x1a,0x0d,0xf6,0x49,0x1f,0x42,0x62,0x67,0x23,0x58,0xcc,0xc2,
+    0x09,0xab,0x3e,0x56,0xe8,0x80,0x34,0xd0,0x22,0x50,0x8b,0x2b,0x19,0x0a,0x03,0x64,0x20,0xa1,0x64,0xbc,
+    0x28,0x0d,0xa8,0x0e,0xba,0x0c,0x54,0xaf,0x0a,0xc8,0xaa,0x17,0x02,0xaf,0xc3,0x4c,0x28,0x72,0x16,0xdd,
+    0x21,0xb6,0x4d,0xee,0x8c,0x1d,0x78,0x99,0x91,0x9f,0x4e,0xdd,0x69,0x98,0xde,0x5e,0x89,0xd5,0x83,0x82,
+    0x1b,0x45,0x52,0x49,0xf6,0x81,0xf7,0xc7,0x56,0xef,0x9d,0xab,0x3a,0x24,0x47,0xf3,0x23,0x1a,0x6d,0x1d,
+    0xb5,0x17,0xb7,0x2f,0x92,0x2c,0x75,0x0d,0x3b,0x0b,0xc5,0xad,0xb9,0x3d,0xa5,0xb0,0x54,0x2b,0xe8,0x8a,
+    0xbb,0x30,0xf3,0xaf,0xe6,0xd9,0xe1,0x74,0xf3,0x6d,0xc5,0x28,0xc7,0xee,0x6d,0xbf,0x1c,0x1d,0x42,0xc1,
+    0x51,0xd3,0xb7,0xc8,0x5e,0x7f,0x6d,0x62,0xbf,0xef,0xe5,0xd8,0xef,0x46,0x69,0x10,0xdb,0x4e,0x4d,0x63,
+    0xca,0x57,0x88,0x08,0x5c,0xd7,0x89,0xb3,0x6b,0x40,0x67,0x3f,0x0c,0x58,0x76,0x00,0x67,0x69,0xfb,0xba,
+    0xbd,0x6c,0xdf,0xfd,0xf7,0x47,0xfb,0xe6,0xfa,0xf7,0xab,0x97,0xa8,0x7d,0x7b,0xf5,0x5b,0x7b,0x09,0x78,
+    0x33,0x3b,0x28,0xdd,0x9d,0x23,0x4e,0x13,0xa7,0x72,0x90,0x92,0x30,0xa4,0xb2,0x80,0x81,0x14,0x0a,0x53,
+    0x77,0x04,0xe7,0xd5,0xc2,0xde,0x12,0x5a,0x61,0xb1,0x84,0x30,0xcc,0xdc,0x04,0xb5,0x7f,0x03,0xde,0xbf,
+    0xed,0xeb,0xd8,0xef,0x37,0x01,0x66,0x3f,0x6b,0xea,0xa4,0xed,0x25,0x14,0x79,0x77,0xf5,0xaa,0x7d,0xbf,
+    0xcb,0xfa,0x20,0x69,0xe6,0xa4,0xd7,0x7f,0x5d,0xfd,0x7a,0xbb,0xed,0xf7,0x5c,0x00,0xcd,0xaa,0xb0,0x8c,
+    0x08,0xd4,0xf7,0x61,0x91,0xc6,0xd9,0x12,0xba,0x47,0xde,0x48,0x03,0x73,0x3b,0xae,0x82,0x93,0x33,0x4b,
+    0x95,0x60,0x8b,0xe0,0x95,0x9a,0xe5,0xc9,0xd0,0xff,0xa6,0x4e,0x86,0xf7,0x4e,0x80,0xc2,0x9f,0x40,0xf3,
+    0xfd,0xf5,0xdb,0xf6,0x1f,0x4b,0xb5,0x47,0xb8,0xc1,0xeb,0x7e,0x41,0x3d,0xd1,0x7c,0x61,0x52,0x70,0xb0,
+    0x36,0xe8,0x24,0x91,0xec,0x1c,0x3d,0xfb,0xf9,0xf1,0x09,0xc3,0x9a,0x94,0x4f,0xb1,0xc6,0x55,0xed,0xee,
+    0xd0,0xeb,0x2e,0x3a,0xf2,0x0a,0x66,0xdc,0x61,0x3d,0x1c,0xbd,0x78,0x11,0x44,0x83,0x7c,0x29,0xbb,0x2e,
+    0x46,0xbd,0x5f,0x4d,0x8f,0x54,0x25,0x54,0x91,0x65,0x05,0x83,0x66,0xb3,0x1f,0x0a,0x66,0xff,0x7e,0xb7,
+    0xfe,0x91,0xba,0xc3,0x6a,0x38,0xf2,0x3a,0x03,0xe0,0x2c,0x33,0xa4,0x74,0x87,0xbe,0x7d,0x2f,0x1a,0x0f,
+    0xda,0xbd,0x27,0x7e,0x6f,0xf8,0x45,0x05,0xcf,0x6a,0xe4,0x99,0x92,0x49,0x57,0x27,0xa9,0xf6,0xec,0xf8,
+    0xba,0xa3,0x6d,0xc4,0x24,0x69,0xf3,0x49,0x7c,0x02,0xf8,0x5c,0x42,0x33,0x3c,0x3a,0x7d,0xf2,0x38,0x31,
+    0xd1,0x66,0x14,0x6d,0x7a,0x6e,0x11,0x18,0xdc,0xcb,0x05,0x33,0xba,0x1e,0xf2,0xbb,0xb7,0xf7,0xff,0x58,
+    0x0f,0x15,0x9b,0xcd,0x05,0x00,0x00,
+};
+const size_t HISTORY_HTML_GZ_LEN = 867;
+const char HISTORY_HTML_ETAG[] = "\"f11fa8a76f5d9ffe\"";
+
+#endif // WEB_PAGES_GZ_H
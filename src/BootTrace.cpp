@@ -0,0 +1,47 @@
+/**
+ * @file BootTrace.cpp
+ * @brief Implementation of the boot timing record.
+ */
+
+#include "BootTrace.h"
+
+struct BootMark {
+    const char *name;
+    uint32_t value;  ///< Phase duration in µs, or milestone time in ms
+};
+
+static BootMark phases[BOOT_MAX_MARKS];
+static BootMark milestones[BOOT_MAX_MARKS];
+static uint8_t phaseCount = 0;
+static uint8_t milestoneCount = 0;
+static uint32_t phaseStart = 0;
+
+void bootPhase(const char *name) {
+    uint32_t now = micros();
+    if (phaseCount < BOOT_MAX_MARKS) phases[phaseCount++] = {name, now - phaseStart};
+    phaseStart = now;
+}
+
+void bootMilestone(const char *name) {
+    if (bootReached(name) || milestoneCount == BOOT_MAX_MARKS) return;
+    milestones[milestoneCount++] = {name, (uint32_t)millis()};
+}
+
+bool bootReached(const char *name) {
+    for (uint8_t i = 0; i < milestoneCount; i++) {
+        if (strcmp(milestones[i].name, name) == 0) return true;
+    }
+    return false;
+}
+
+void bootWriteDiag(Print &out) {
+    out.print("{\"phasesUs\":{");
+    for (uint8_t i = 0; i < phaseCount; i++) {
+        out.printf("%s\"%s\":%u", i ? "," : "", phases[i].name, phases[i].value);
+    }
+    out.print("},\"milestonesMs\":{");
+    for (uint8_t i = 0; i < milestoneCount; i++) {
+        out.printf("%s\"%s\":%u", i ? "," : "", milestones[i].name, milestones[i].value);
+    }
+    out.print("}}");
+}
@@ -0,0 +1,36 @@
+/**
+ * @file BootTrace.h
+ * @brief Time spent in each start-up phase, and when the device first
+ *        reached a milestone (first logged sample, Wi-Fi, web server).
+ */
+
+#ifndef BOOT_TRACE_H
+#define BOOT_TRACE_H
+
+#include <Arduino.h>
+#include "AppConfig.h"
+
+/**
+ * @brief Ends a setup() phase.
+ * @param name Static name; the phase runs from the previous bootPhase()
+ *        call (or from reset for the first one) to now.
+ */
+void bootPhase(const char *name);
+
+/**
+ * @brief Records the time since reset at which `name` first happened.
+ *        Later calls with the same name are ignored.
+ */
+void bootMilestone(const char *name);
+
+/**
+ * @brief true once bootMilestone(name) has been recorded.
+ */
+bool bootReached(const char *name);
+
+/**
+ * @brief Writes the phases (µs) and milestones (ms) as a JSON object.
+ */
+void bootWriteDiag(Print &out);
+
+#endif // BOOT_TRACE_H
@@ -0,0 +1,125 @@
+/**
+ * @file ChunkedPrint.h
+ * @brief Print adapter that streams a response body as HTTP chunks.
+ * @details Output is collected in a small fixed buffer and handed to
+ *          ESP8266WebServer::sendContent() whenever the buffer fills, so a
+ *          response of any length never needs more than `Size` bytes of RAM.
+ */
+
+#ifndef CHUNKED_PRINT_H
+#define CHUNKED_PRINT_H
+
+#include <Arduino.h>
+#include <ESP8266WebServer.h>
+
+template <size_t Size = 256>
+class ChunkedPrint : public Print {
+public:
+    /**
+     * @brief Starts a chunked response with the given status and type.
+     */
+    ChunkedPrint(ESP8266WebServer &server, int code, const char *contentType)
+        : _server(server) {
+        _server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+        _server.send(code, contentType, "");
+    }
+
+    /**
+     * @brief Sends any buffered bytes and the terminating chunk.
+     */
+    ~ChunkedPrint() {
+        flush();
+        _server.sendContent("");
+    }
+
+    size_t write(uint8_t c) override {
+        if (_len == Size) flush();
+        _buf[_len++] = (char)c;
+        return 1;
+    }
+
+    size_t write(const uint8_t *data, size_t size) override {
+        size_t left = size;
+        while (left > 0) {
+            if (_len == Size) flush();
+            size_t n = Size - _len;
+            if (n > left) n = left;
+            memcpy(_buf + _len, data, n);
+            _len += n;
+            data += n;
+            left -= n;
+        }
+        return size;
+    }
+
+    void flush() override {
+        if (_len == 0) return;
+        _server.sendContent(_buf, _len);
+        _len = 0;
+    }
+
+private:
+    ESP8266WebServer &_server;
+    char _buf[Size];
+    size_t _len = 0;
+};
+
+/**
+ * @brief Same chunk framing written directly to a client connection that
+ *        was taken over from the web server (see StreamJob).
+ */
+template <size_t Size = 512>
+class ClientChunkedPrint : public Print {
+public:
+    void begin(WiFiClient client) {
+        _client = client;
+        _len = 0;
+    }
+
+    /**
+     * @brief Sends any buffered bytes and the terminating chunk.
+     */
+    void end() {
+        flush();
+        _client.print("0\r\n\r\n");
+    }
+
+    size_t write(uint8_t c) override {
+        if (_len == Size) flush();
+        _buf[_len++] = (char)c;
+        return 1;
+    }
+
+    size_t write(const uint8_t *data, size_t size) override {
+        size_t left = size;
+        while (left > 0) {
+            if (_len == Size) flush();
+            size_t n = Size - _len;
+            if (n > left) n = left;
+            memcpy(_buf + _len, data, n);
+            _len += n;
+            data += n;
+            left -= n;
+        }
+        return size;
+    }
+
+    void flush() override {
+        if (_len == 0) return;
+        char head[8];
+        int n = snprintf(head, sizeof(head), "%X\r\n", (unsigned)_len);
+        _client.write((const uint8_t *)head, n);
+        _client.write((const uint8_t *)_buf, _len);
+        _client.write((const uint8_t *)"\r\n", 2);
+        _len = 0;
+    }
+
+    WiFiClient &client() { return _client; }
+
+private:
+    WiFiClient _client;
+    char _buf[Size];
+    size_t _len = 0;
+};
+
+#endif // CHUNKED_PRINT_H
@@ -0,0 +1,230 @@
+/**
+ * @file ConfigStore.cpp
+ * @brief Implementation of the config journal.
+ */
+
+#include "ConfigStore.h"
+#include <flash_hal.h>
+
+extern "C" uint32_t _EEPROM_start;
+
+static const uint16_t RECORD_MAGIC = 0xC57A;
+static const uint16_t PAYLOAD_MAX = 128;          // Longest record a later schema may write
+static const uint32_t LEGACY_V2_MAGIC = 0x32474643; // "CFG2"
+
+/**
+ * @brief Header in front of every record; the payload follows, padded to
+ *        a multiple of 4 bytes.
+ */
+struct RecordHeader {
+    uint16_t magic;
+    uint16_t length;  ///< Payload bytes
+    uint32_t seq;     ///< Grows by one per record, across erases
+    uint32_t crc;     ///< CRC-32 of length, seq and the payload
+};
+
+/**
+ * @brief EEPROM layout of schema 2 ("CFG2" magic, centi-degree limits).
+ */
+struct LegacyConfigV2 {
+    uint32_t magic;
+    SensorLimits limits[MAX_SENSORS];
+    uint8_t webSoundEnabled;
+};
+
+/**
+ * @brief EEPROM layout of schema 1: the single-sensor firmware's
+ *        SystemConfig, written with EEPROM.put() (float limits, no magic).
+ */
+struct LegacyConfigV1 {
+    float greenLimit;
+    float yellowLimit;
+    uint8_t webSoundEnabled;
+};
+
+static SystemConfig *live = nullptr;
+static SystemConfig stored;       // Content of the newest record
+static bool storedValid = false;  // False if the newest record is missing or of an older schema
+static uint32_t sectors[2];       // EEPROM sector, and the spare one before it (0 if there is none)
+static uint8_t active;            // Sector that receives the next record
+static uint32_t sectorAddress;    // Address of the active sector
+static uint32_t nextOffset;
+static uint32_t nextSeq;
+static bool dirty = false;
+static unsigned long changedMs;
+
+static uint32_t recordSize(uint16_t length) {
+    return sizeof(RecordHeader) + ((length + 3u) & ~3u);
+}
+
+static uint32_t crc32(uint32_t crc, const void *data, size_t size) {
+    const uint8_t *p = (const uint8_t *)data;
+    while (size--) {
+        crc ^= *p++;
+        for (uint8_t k = 0; k < 8; k++) crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+    }
+    return crc;
+}
+
+static uint32_t recordCrc(const RecordHeader &h, const void *payload) {
+    uint32_t crc = crc32(0xFFFFFFFF, &h.length, sizeof(h.length));
+    crc = crc32(crc, &h.seq, sizeof(h.seq));
+    return ~crc32(crc, payload, h.length);
+}
+
+/**
+ * @brief Checks that `size` bytes at `offset` are still erased.
+ */
+static bool isErased(uint32_t offset, uint32_t size) {
+    uint32_t word;
+    for (uint32_t i = 0; i < size; i += 4) {
+        ESP.flashRead(sectorAddress + offset + i, &word, 4);
+        if (word != 0xFFFFFFFF) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Converts the EEPROM image left by earlier firmware.
+ * @return Its schema, or 0 if the sector holds neither layout.
+ */
+static uint16_t importLegacy(SystemConfig &cfg) {
+    static_assert(sizeof(LegacyConfigV1) <= sizeof(LegacyConfigV2), "raw holds the larger layout");
+    uint32_t raw[(sizeof(LegacyConfigV2) + 3) / 4];
+    ESP.flashRead(sectors[0], raw, sizeof(raw));
+    if (raw[0] == LEGACY_V2_MAGIC) {
+        LegacyConfigV2 v2;
+        memcpy(&v2, raw, sizeof(v2));
+        memcpy(cfg.limits, v2.limits, sizeof(cfg.limits));
+        // Erased cells (0xFF) read as "sound on", as EEPROM.get() of a bool did
+        cfg.webSoundEnabled = v2.webSoundEnabled != 0;
+        return 2;
+    }
+    if (raw[0] == 0xFFFFFFFF) return 0;
+
+    LegacyConfigV1 v1;
+    memcpy(&v1, raw, sizeof(v1));
+    cfg.webSoundEnabled = v1.webSoundEnabled != 0;
+    // Out-of-range values (NaN of erased cells) leave sensor 0 to the
+    // caller's defaults, as do the sensors this firmware did not have.
+    float g = v1.greenLimit, y = v1.yellowLimit;
+    if (g > -100 && g < 150 && y > -100 && y < 150) {
+        cfg.limits[0].green = (int16_t)lroundf(g * 100);
+        cfg.limits[0].yellow = (int16_t)lroundf(y * 100);
+    }
+    return 1;
+}
+
+/**
+ * @brief Walks the records of one sector.
+ * @param newest Receives the offset of the last valid record whose
+ *        sequence number is at least `newestSeq`, which is raised to it.
+ * @return Offset after the last record.
+ */
+static uint32_t scanSector(uint32_t address, int32_t &newest, uint32_t &newestSeq) {
+    uint32_t payload[PAYLOAD_MAX / 4];
+    uint32_t offset = 0;
+    while (offset + sizeof(RecordHeader) <= SPI_FLASH_SEC_SIZE) {
+        RecordHeader h;
+        ESP.flashRead(address + offset, (uint32_t *)&h, sizeof(h));
+        uint32_t size = recordSize(h.length);
+        if (h.magic != RECORD_MAGIC || h.length > PAYLOAD_MAX || offset + size > SPI_FLASH_SEC_SIZE) break;
+        ESP.flashRead(address + offset + sizeof(h), payload, size - sizeof(h));
+        if (recordCrc(h, payload) == h.crc && h.seq >= newestSeq) {
+            newest = offset;
+            newestSeq = h.seq;
+        }
+        offset += size;
+    }
+    return offset;
+}
+
+uint16_t configBegin(SystemConfig &cfg) {
+    live = &cfg;
+    sectors[0] = (uint32_t)((uintptr_t)&_EEPROM_start - 0x40200000) / SPI_FLASH_SEC_SIZE * SPI_FLASH_SEC_SIZE;
+    // The file system ends on a block boundary; the sector left between it
+    // and the EEPROM sector (if any) takes every other generation.
+    sectors[1] = sectors[0] - (FS_PHYS_ADDR + FS_PHYS_SIZE) >= SPI_FLASH_SEC_SIZE ? sectors[0] - SPI_FLASH_SEC_SIZE : 0;
+    storedValid = false;
+    dirty = false;
+
+    // The valid record with the highest sequence number is the newest
+    int32_t newest = -1;
+    uint32_t newestSeq = 0, ends[2] = {0, 0};
+    active = 0;
+    for (uint8_t i = 0; i < 2 && sectors[i] != 0; i++) {
+        int32_t found = -1;
+        ends[i] = scanSector(sectors[i], found, newestSeq);
+        if (found >= 0) {
+            newest = found;
+            active = i;
+        }
+    }
+    sectorAddress = sectors[active];
+    nextSeq = newestSeq + 1;
+    // Anything after the last record that is not erased (a torn header)
+    // makes the next append move to the other sector.
+    nextOffset = ends[active];
+
+    if (newest < 0) return ends[0] == 0 ? importLegacy(cfg) : 0;
+
+    uint32_t payload[PAYLOAD_MAX / 4];
+    RecordHeader h;
+    ESP.flashRead(sectorAddress + newest, (uint32_t *)&h, sizeof(h));
+    ESP.flashRead(sectorAddress + newest + sizeof(h), payload, recordSize(h.length) - sizeof(h));
+    uint16_t schema;
+    memcpy(&schema, payload, sizeof(schema));
+    // Fields added by later schemas are appended, so a shorter record leaves
+    // them at the caller's defaults. Per-schema conversions would go here.
+    memcpy(&cfg, payload, h.length < sizeof(cfg) ? h.length : sizeof(cfg));
+    cfg.schema = CONFIG_SCHEMA;
+
+    stored = cfg;
+    storedValid = schema == CONFIG_SCHEMA && h.length == sizeof(cfg);
+    return schema;
+}
+
+void configChanged(unsigned long nowMs) {
+    dirty = true;
+    changedMs = nowMs;
+}
+
+bool configTask(unsigned long nowMs) {
+    if (dirty && nowMs - changedMs >= CONFIG_COMMIT_DELAY_MS) configCommit();
+    return false;
+}
+
+bool configCommit() {
+    if (live == nullptr) return false;
+    dirty = false;
+    if (storedValid && memcmp(&stored, live, sizeof(stored)) == 0) return false;
+
+    uint32_t buf[(sizeof(RecordHeader) + sizeof(SystemConfig) + 3) / 4] = {0};
+    RecordHeader &h = *(RecordHeader *)buf;
+    h.magic = RECORD_MAGIC;
+    h.length = sizeof(SystemConfig);
+    h.seq = nextSeq;
+    memcpy(&buf[sizeof(RecordHeader) / 4], live, sizeof(SystemConfig));
+    h.crc = recordCrc(h, &buf[sizeof(RecordHeader) / 4]);
+
+    uint32_t size = recordSize(h.length);
+    if (nextOffset + size > SPI_FLASH_SEC_SIZE || !isErased(nextOffset, size)) {
+        // Sector full: continue on the other one. The newest record stays
+        // in this sector until the next switch, so a power loss before the
+        // record below lands falls back to it. (Without a spare sector the
+        // only one is erased, and such a power loss loses the config.)
+        if (sectors[1] != 0) active ^= 1;
+        sectorAddress = sectors[active];
+        ESP.flashEraseSector(sectorAddress / SPI_FLASH_SEC_SIZE);
+        nextOffset = 0;
+    }
+    if (!ESP.flashWrite(sectorAddress + nextOffset, buf, size)) {
+        dirty = true;  // Retried by configTask()
+        return false;
+    }
+    nextOffset += size;
+    nextSeq++;
+    stored = *live;
+    storedValid = true;
+    return true;
+}
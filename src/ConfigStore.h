@@ -0,0 +1,56 @@
+/**
+ * @file ConfigStore.h
+ * @brief Journaled, wear-leveled storage of SystemConfig.
+ * @details The flash sector reserved for the EEPROM emulation and the spare
+ *          sector between it and the end of the file system are used as an
+ *          append-only journal. Every save appends one record: a header
+ *          with a sequence number and a CRC-32, followed by the config. On
+ *          boot, the valid record with the highest sequence in either
+ *          sector wins, so a write torn by a power loss falls back to the
+ *          previous one. When a sector is full the journal continues on the
+ *          other one, which is erased first; the full sector keeps the
+ *          newest record until then. A sector is erased once per ~100
+ *          saves instead of on every commit as EEPROM.commit() does.
+ *
+ *          Changes are not written from the request handler. configChanged()
+ *          marks the config dirty and configTask() writes it once no change
+ *          has come in for CONFIG_COMMIT_DELAY_MS, and only if it differs
+ *          from the last record. A burst of toggles therefore costs at most
+ *          one record, and none if it ends where it started.
+ */
+
+#ifndef CONFIG_STORE_H
+#define CONFIG_STORE_H
+
+#include <Arduino.h>
+#include "AppConfig.h"
+
+/**
+ * @brief Loads the newest config into `cfg` and keeps `cfg` as the live copy.
+ * @details Fields that the stored record does not contain (older schema, or
+ *          nothing stored) keep the values `cfg` had on entry, so the caller
+ *          fills in the defaults first. The EEPROM layouts of earlier
+ *          firmware are converted. The caller validates the values and calls
+ *          configCommit() to persist a fresh or converted config.
+ * @return Schema of the record that was loaded, or 0 if nothing was stored.
+ */
+uint16_t configBegin(SystemConfig &cfg);
+
+/**
+ * @brief Notes that the live config was modified.
+ * @param nowMs millis() of the change; the write waits for a quiet period.
+ */
+void configChanged(unsigned long nowMs);
+
+/**
+ * @brief Scheduler task: writes a pending change once it has settled.
+ */
+bool configTask(unsigned long nowMs);
+
+/**
+ * @brief Writes the live config now if it differs from the last record.
+ * @return true if a record was written.
+ */
+bool configCommit();
+
+#endif // CONFIG_STORE_H
@@ -0,0 +1,343 @@
+/**
+ * @file DayArchive.cpp
+ * @brief Implementation of the compressed day archive.
+ */
+
+#include "DayArchive.h"
+
+static const uint32_t SEGMENT_MAGIC = 0x31474553; // "SEG1"
+static const uint32_t FIRST_INTERVAL = 60;         // Interval assumed before the first delta (one sample a minute)
+static const uint8_t MAX_ENTRY = 10;               // Two 5-byte varints
+
+static uint32_t zigzag(int32_t v) {
+    return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+static int32_t unzigzag(uint32_t v) {
+    return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+}
+
+static uint8_t putVarint(uint8_t *p, uint32_t v) {
+    uint8_t n = 0;
+    while (v >= 0x80) {
+        p[n++] = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    p[n++] = (uint8_t)v;
+    return n;
+}
+
+/**
+ * @return Bytes consumed, or 0 if the varint does not end within `avail`.
+ */
+static uint8_t getVarint(const uint8_t *p, size_t avail, uint32_t &v) {
+    v = 0;
+    for (uint8_t n = 0; n < 5 && n < avail; n++) {
+        v |= (uint32_t)(p[n] & 0x7F) << (7 * n);
+        if ((p[n] & 0x80) == 0) return n + 1;
+    }
+    return 0;
+}
+
+static uint32_t wholeBlocks(uint32_t size) {
+    return (size + FS_BLOCK_BYTES - 1) / FS_BLOCK_BYTES * FS_BLOCK_BYTES;
+}
+
+static uint32_t fileBytes(const char *path) {
+    File f = LittleFS.open(path, "r");
+    return f ? wholeBlocks(f.size()) : 0;
+}
+
+void DayArchive::filePath(char *out, size_t size, uint16_t key) const {
+    snprintf(out, size, "%s%u.seg", _prefix, (unsigned)key);
+}
+
+bool DayArchive::selectFile(uint16_t key) {
+    if (_fileKey == key) return true;
+    char path[32];
+    filePath(path, sizeof(path), key);
+    _file.close();
+    _file = LittleFS.open(path, "r");
+    _fileKey = _file ? key : -1;
+    _cached = 0;
+    _pos = 0;
+    return _fileKey >= 0;
+}
+
+size_t DayArchive::fetch(uint32_t offset, uint32_t end, uint8_t need, const uint8_t *&data) {
+    uint32_t cacheEnd = _cacheAt + _cached;
+    bool hit = offset >= _cacheAt && offset < cacheEnd;
+    if (!hit || (cacheEnd - offset < need && cacheEnd < end)) {
+        // Keep a partial entry at the end of the cache and go on reading
+        // sequentially; seek only on a jump.
+        uint8_t keep = 0;
+        if (hit && _pos == cacheEnd) {
+            keep = (uint8_t)(cacheEnd - offset);
+            memmove(_buf, _buf + (offset - _cacheAt), keep);
+        } else if (offset != _pos && !_file.seek(offset)) {
+            return 0;
+        }
+        _cacheAt = offset;
+        _cached = keep + (uint8_t)_file.read(_buf + keep, sizeof(_buf) - keep);
+        _pos = cacheEnd = offset + _cached;
+    }
+    data = _buf + (offset - _cacheAt);
+    return (end < cacheEnd ? end : cacheEnd) - offset;
+}
+
+bool DayArchive::readHeader(uint16_t key, uint32_t offset, SegmentHeader &hdr) {
+    const uint8_t *data;
+    if (!selectFile(key) || fetch(offset, UINT32_MAX, sizeof(hdr), data) < sizeof(hdr)) return false;
+    memcpy(&hdr, data, sizeof(hdr));
+    // The magic is written after the deltas, so it marks a complete segment
+    return hdr.magic == SEGMENT_MAGIC && hdr.count > 0;
+}
+
+bool DayArchive::begin(const char *prefix) {
+    strncpy(_prefix, prefix, sizeof(_prefix) - 1);
+    _file.close();
+    _fileKey = -1;
+    _writing = false;
+    _files = 0;
+    _end = 0;
+    _bytes = 0;
+    _nextDay = 0;
+
+    uint32_t key;
+    size_t size;
+    SeriesDir d(_prefix, ".seg");
+    while (d.next(key, size)) {
+        if (key > UINT16_MAX) continue;
+        _bytes += wholeBlocks(size);
+        if (_files == 0 || key < _firstKey) _firstKey = (uint16_t)key;
+        if (_files == 0 || key > _lastKey) _lastKey = (uint16_t)key;
+        _files++;
+    }
+
+    // Walk the newest file to its end. One without a complete segment
+    // (torn before its first seal finished) is dropped.
+    while (_files > 0) {
+        SegmentHeader hdr;
+        uint32_t offset = 0;
+        while (readHeader(_lastKey, offset, hdr)) {
+            offset += sizeof(hdr) + hdr.bytes;
+            _nextDay = hdr.start / 86400 + 1;
+        }
+        if (offset > 0) {
+            _end = offset;
+            break;
+        }
+
+        char path[32];
+        filePath(path, sizeof(path), _lastKey);
+        _file.close();
+        _fileKey = -1;
+        _bytes -= fileBytes(path);
+        LittleFS.remove(path);
+        if (--_files == 0) break;
+        do {
+            filePath(path, sizeof(path), --_lastKey);
+        } while (_lastKey > _firstKey && !LittleFS.exists(path));
+    }
+    // Nothing is read until the next export
+    release();
+    return true;
+}
+
+bool DayArchive::open(uint32_t day) {
+    uint32_t key = day / LOG_ARCHIVE_FILE_DAYS;
+    if (_writing || day < _nextDay || key > UINT16_MAX) return false;
+
+    bool append = _files > 0 && key == _lastKey;
+    char path[32];
+    filePath(path, sizeof(path), (uint16_t)key);
+    _file.close();
+    _file = LittleFS.open(path, append ? "r+" : "w");
+    _fileKey = -1;
+    _cached = 0;
+    if (!_file) return false;
+    _openBytes = append ? wholeBlocks(_file.size()) : 0;
+
+    // The header goes in last; until then the segment reads as torn.
+    _segment = append ? _end : 0;
+    _hdr = {};
+    if (!_file.seek(_segment) || _file.write((const uint8_t *)&_hdr, sizeof(_hdr)) != sizeof(_hdr)) {
+        _file.close();
+        return false;
+    }
+    _dt = FIRST_INTERVAL;
+    _used = 0;
+    _writing = true;
+    return true;
+}
+
+bool DayArchive::add(const LogRecord &rec) {
+    if (!_writing) return false;
+    if (_hdr.count == 0) {
+        _hdr.start = _hdr.last = rec.timestamp;
+        _hdr.first = _hdr.min = _hdr.max = _prev = rec.centi;
+        _hdr.count = 1;
+        return true;
+    }
+    if (rec.timestamp <= _hdr.last || _hdr.count == UINT16_MAX || _hdr.bytes > UINT16_MAX - MAX_ENTRY) return false;
+    if (_used > sizeof(_buf) - MAX_ENTRY && !flush()) return false;
+
+    // Flag bit set: same interval as the previous sample, none follows.
+    uint32_t dt = rec.timestamp - _hdr.last;
+    uint32_t tag = zigzag((int32_t)rec.centi - _prev) << 1 | (dt == _dt ? 1 : 0);
+    uint8_t len = putVarint(_buf + _used, tag);
+    if (dt != _dt) len += putVarint(_buf + _used + len, dt);
+    _used += len;
+    _dt = dt;
+    _prev = rec.centi;
+
+    _hdr.bytes += len;
+    _hdr.count++;
+    _hdr.last = rec.timestamp;
+    if (rec.centi < _hdr.min) _hdr.min = rec.centi;
+    if (rec.centi > _hdr.max) _hdr.max = rec.centi;
+    return true;
+}
+
+bool DayArchive::flush() {
+    bool ok = _file.write(_buf, _used) == _used;
+    _used = 0;
+    return ok;
+}
+
+bool DayArchive::seal() {
+    if (!_writing) return false;
+    _writing = false;
+    bool ok = _hdr.count > 0 && flush();
+    if (ok) {
+        _hdr.magic = SEGMENT_MAGIC;
+        ok = _file.seek(_segment) && _file.write((const uint8_t *)&_hdr, sizeof(_hdr)) == sizeof(_hdr);
+    }
+    uint32_t sealedBytes = wholeBlocks(_file.size());
+    _file.close();
+    if (!ok) return false;
+    _bytes += sealedBytes - _openBytes;
+
+    uint16_t key = (uint16_t)(_hdr.start / 86400 / LOG_ARCHIVE_FILE_DAYS);
+    if (_files == 0) _firstKey = key;
+    if (_files == 0 || key != _lastKey) {
+        _lastKey = key;
+        _files++;
+    }
+    _end = _segment + sizeof(_hdr) + _hdr.bytes;
+    _nextDay = _hdr.start / 86400 + 1;
+
+    while (_files > LOG_ARCHIVE_FILES) dropOldest();
+    return true;
+}
+
+bool DayArchive::dropOldest() {
+    if (_writing || _files == 0) return false;
+    char path[32];
+    filePath(path, sizeof(path), _firstKey);
+    if (_fileKey == _firstKey) release();
+    uint32_t size = fileBytes(path);
+    LittleFS.remove(path);
+    _bytes = _bytes > size ? _bytes - size : 0;
+    if (--_files == 0) {
+        _end = 0;
+        return true;
+    }
+    do {
+        filePath(path, sizeof(path), ++_firstKey);
+    } while (_firstKey < _lastKey && !LittleFS.exists(path));
+    return true;
+}
+
+bool DayArchive::rewind(ArchiveCursor &cur, uint32_t from) const {
+    if (_files == 0) return false;
+    cur = {};
+    uint32_t key = from / 86400 / LOG_ARCHIVE_FILE_DAYS;
+    cur.file = key < _firstKey ? _firstKey : key > _lastKey ? _lastKey + 1 : key;
+    return true;
+}
+
+size_t DayArchive::read(ArchiveCursor &cur, uint32_t from, LogRecord *out, size_t n) {
+    size_t got = 0;
+    while (got < n && _files > 0 && cur.file <= _lastKey && !_writing) {
+        if (cur.index == 0) {
+            SegmentHeader hdr;
+            if (!readHeader(cur.file, cur.segment, hdr)) {
+                // End of this file, or no file for these days
+                cur.file++;
+                cur.segment = 0;
+                continue;
+            }
+            if (hdr.last < from) {
+                cur.segment += sizeof(hdr) + hdr.bytes;
+                continue;
+            }
+            cur.count = hdr.count;
+            cur.bytes = hdr.bytes;
+            cur.offset = 0;
+            cur.index = 1;
+            cur.ts = hdr.start;
+            cur.centi = hdr.first;
+            cur.dt = FIRST_INTERVAL;
+            if (cur.ts >= from) out[got++] = {cur.ts, cur.centi};
+            continue;
+        }
+        if (cur.index >= cur.count || !selectFile(cur.file)) {
+            cur.segment += sizeof(SegmentHeader) + cur.bytes;
+            cur.index = 0;
+            continue;
+        }
+
+        uint32_t base = cur.segment + sizeof(SegmentHeader);
+        const uint8_t *data;
+        size_t avail = fetch(base + cur.offset, base + cur.bytes, MAX_ENTRY, data);
+        size_t pos = 0;
+        while (got < n && cur.index < cur.count) {
+            uint32_t tag, dt = cur.dt;
+            uint8_t len;
+            if (pos < avail && (data[pos] & 0x81) == 0x01) {
+                // Common case: one byte, same interval
+                tag = data[pos];
+                len = 1;
+            } else {
+                len = getVarint(data + pos, avail - pos, tag);
+            }
+            if (len > 0 && (tag & 1) == 0) {
+                uint8_t more = getVarint(data + pos + len, avail - pos - len, dt);
+                len = more > 0 ? len + more : 0;
+            }
+            if (len == 0) break;  // Entry continues past the cached bytes
+            pos += len;
+            cur.dt = dt;
+            cur.ts += dt;
+            cur.centi = (int16_t)(cur.centi + unzigzag(tag >> 1));
+            cur.index++;
+            if (cur.ts >= from) out[got++] = {cur.ts, cur.centi};
+        }
+        // Nothing decodable: the segment is damaged, skip its remainder
+        if (pos == 0) cur.index = cur.count;
+        cur.offset += pos;
+    }
+    return got;
+}
+
+void DayArchive::release() {
+    if (_writing) return;
+    _file.close();
+    _fileKey = -1;
+}
+
+void DayArchive::clear() {
+    _file.close();
+    _fileKey = -1;
+    _writing = false;
+    char path[32];
+    for (uint32_t key = _firstKey; _files > 0 && key <= _lastKey; key++) {
+        filePath(path, sizeof(path), (uint16_t)key);
+        LittleFS.remove(path);
+    }
+    _files = 0;
+    _end = 0;
+    _bytes = 0;
+    _nextDay = 0;
+}
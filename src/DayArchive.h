@@ -0,0 +1,163 @@
+/**
+ * @file DayArchive.h
+ * @brief Compressed long-term store of raw samples, one sealed segment per
+ *        day.
+ * @details Days that are complete in the raw ring are sealed into
+ *          segments. A segment header carries the time span, sample count
+ *          and value range; the samples follow as deltas to the previous
+ *          one. Each delta is a zigzag varint with one flag bit that says
+ *          whether the interval is the same as before; only a changed
+ *          interval is written as a second varint. A one-minute log whose
+ *          value moves a few hundredths per sample takes about one byte per
+ *          sample instead of the six of a LogRecord.
+ *
+ *          Segments are appended to files that cover LOG_ARCHIVE_FILE_DAYS
+ *          days each (named after day / LOG_ARCHIVE_FILE_DAYS), so that a
+ *          day does not cost a whole LittleFS block. The oldest file is
+ *          removed once more than LOG_ARCHIVE_FILES exist, or earlier by
+ *          dropOldest() when the space left to the archives runs out
+ *          (see logArchive()). A segment's
+ *          magic is written last, so one torn by a power loss is ignored
+ *          and overwritten by the next seal.
+ */
+
+#ifndef DAY_ARCHIVE_H
+#define DAY_ARCHIVE_H
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "AppConfig.h"
+#include "LogStore.h"
+
+/**
+ * @brief On-flash header in front of every segment.
+ */
+struct __attribute__((packed)) SegmentHeader {
+    uint32_t magic;
+    uint32_t start;   ///< Timestamp of the first sample
+    uint32_t last;    ///< Timestamp of the last sample
+    uint16_t count;   ///< Samples in the segment
+    uint16_t bytes;   ///< Encoded deltas following the header
+    int16_t first;    ///< Value of the first sample (centi-degrees)
+    int16_t min;
+    int16_t max;
+};
+
+/**
+ * @brief Read position in the archive; plain data, so it can be kept
+ *        between the slices of a streamed response.
+ */
+struct ArchiveCursor {
+    uint16_t file;     ///< Key of the file being read
+    uint32_t segment;  ///< Offset of the current segment header
+    uint16_t count;    ///< Samples in the current segment
+    uint16_t bytes;    ///< Delta bytes in the current segment
+    uint16_t offset;   ///< Delta bytes of it already decoded
+    uint16_t index;    ///< Samples of it already returned (0: header not read yet)
+    uint32_t ts;       ///< Last returned sample
+    int16_t centi;
+    uint32_t dt;       ///< Current interval
+};
+
+class DayArchive {
+public:
+    /**
+     * @brief Scans the archive files and finds the end of the newest one.
+     * @param prefix Directory and base name of the files; they are named
+     *        `<prefix><key>.seg`.
+     */
+    bool begin(const char *prefix);
+
+    /**
+     * @brief First day (Unix time / 86400) that has not been sealed yet,
+     *        or 0 if the archive is empty.
+     */
+    uint32_t nextDay() const { return _nextDay; }
+
+    /**
+     * @brief Starts the segment of `day`; feed its samples with add() in
+     *        time order and finish it with seal().
+     */
+    bool open(uint32_t day);
+
+    /**
+     * @brief Adds one sample to the open segment.
+     * @return false if the sample was dropped: the segment is full or the
+     *         sample is not newer than the previous one.
+     */
+    bool add(const LogRecord &rec);
+
+    /**
+     * @brief Completes the open segment and drops the oldest file if the
+     *        archive grew past LOG_ARCHIVE_FILES.
+     */
+    bool seal();
+
+    /**
+     * @brief Flash taken by the archive files, in whole LittleFS blocks.
+     */
+    uint32_t bytes() const { return _bytes; }
+
+    /**
+     * @brief Removes the oldest file.
+     * @return false if there is none, or a segment is open.
+     */
+    bool dropOldest();
+
+    /**
+     * @brief Positions `cur` at the first file that can hold `from`.
+     * @return false if the archive is empty.
+     */
+    bool rewind(ArchiveCursor &cur, uint32_t from) const;
+
+    /**
+     * @brief Decodes the next samples at or after `from`, in time order.
+     * @details Segments that end before `from` are skipped by their header
+     *          alone. Decoding goes through a small fixed buffer.
+     * @return Number of records written to `out`; 0 at the end of the
+     *         archive.
+     */
+    size_t read(ArchiveCursor &cur, uint32_t from, LogRecord *out, size_t n);
+
+    /**
+     * @brief Closes the read handle; read() reopens it where it left off.
+     *        A segment being written stays open.
+     */
+    void release();
+
+    /**
+     * @brief Removes every archive file.
+     */
+    void clear();
+
+private:
+    void filePath(char *out, size_t size, uint16_t key) const;
+    bool selectFile(uint16_t key);
+    size_t fetch(uint32_t offset, uint32_t end, uint8_t need, const uint8_t *&data);
+    bool readHeader(uint16_t key, uint32_t offset, SegmentHeader &hdr);
+    bool flush();
+
+    char _prefix[24] = {0};
+    File _file;                ///< Reader, or the file being written while a segment is open
+    int32_t _fileKey = -1;     ///< Key of the reader, -1 if none is open
+    uint32_t _pos = 0;         ///< Position of the reader
+    uint16_t _firstKey = 0;
+    uint16_t _lastKey = 0;
+    uint8_t _files = 0;
+    uint32_t _end = 0;         ///< Append offset in the newest file
+    uint32_t _bytes = 0;       ///< Sum of the file sizes, rounded up to whole blocks
+    uint32_t _nextDay = 0;
+
+    bool _writing = false;
+    SegmentHeader _hdr = {};
+    uint32_t _segment = 0;     ///< Offset of the open segment
+    uint32_t _openBytes = 0;   ///< Block-rounded size of its file when it was opened
+    uint32_t _dt = 0;          ///< Interval of the previous delta
+    int16_t _prev = 0;         ///< Value of the previous sample
+    uint8_t _buf[64];          ///< Deltas not written yet while a segment is open, read cache otherwise
+    uint8_t _used = 0;
+    uint32_t _cacheAt = 0;     ///< Reader offset of _buf[0]
+    uint8_t _cached = 0;
+};
+
+#endif // DAY_ARCHIVE_H
@@ -0,0 +1,85 @@
+/**
+ * @file EventStream.cpp
+ * @brief Implementation of the Server-Sent Events channel.
+ */
+
+#include "EventStream.h"
+
+struct Subscriber {
+    bool used;
+    uint8_t sensor;
+    uint32_t lastHash;
+    unsigned long lastSend;
+    WiFiClient client;
+};
+
+static Subscriber subscribers[SSE_MAX_CLIENTS];
+
+static uint32_t fnv1a(const char *data, int len) {
+    uint32_t h = 2166136261u;
+    for (int i = 0; i < len; i++) {
+        h ^= (uint8_t)data[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+bool eventsSubscribe(WiFiClient client, uint8_t sensor) {
+    for (auto &sub : subscribers) {
+        if (sub.used) continue;
+        sub.used = true;
+        sub.sensor = sensor;
+        sub.lastHash = 0;
+        sub.lastSend = millis();
+        sub.client = client;
+        sub.client.setNoDelay(true);
+        sub.client.print("HTTP/1.1 200 OK\r\n"
+                         "Content-Type: text/event-stream\r\n"
+                         "Cache-Control: no-cache\r\n"
+                         "Connection: keep-alive\r\n"
+                         "\r\n"
+                         "retry: 3000\n\n");
+        return true;
+    }
+    return false;
+}
+
+void eventsPoll(unsigned long nowMs, EventFrameBuilder build) {
+    char frame[384];
+
+    for (auto &sub : subscribers) {
+        if (!sub.used) continue;
+        if (!sub.client.connected()) {
+            sub.client.stop();
+            sub.used = false;
+            continue;
+        }
+
+        // "data: " prefix and blank-line terminator around the JSON.
+        memcpy(frame, "data: ", 6);
+        int len = build(sub.sensor, frame + 6, sizeof(frame) - 8);
+        if (len < 0) continue;
+        if (len > (int)sizeof(frame) - 9) len = sizeof(frame) - 9;
+        frame[6 + len] = '\n';
+        frame[7 + len] = '\n';
+        len += 8;
+
+        uint32_t hash = fnv1a(frame, len);
+        if (hash != sub.lastHash) {
+            sub.client.write((const uint8_t *)frame, len);
+            sub.lastHash = hash;
+            sub.lastSend = nowMs;
+        } else if (nowMs - sub.lastSend >= SSE_KEEPALIVE_MS) {
+            sub.client.print(":\n\n");
+            sub.lastSend = nowMs;
+        }
+    }
+}
+
+uint8_t eventsSubscribers() {
+    uint8_t n = 0;
+    for (auto &sub : subscribers) {
+        if (sub.used) n++;
+    }
+    return n;
+}
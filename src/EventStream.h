@@ -0,0 +1,46 @@
+/**
+ * @file EventStream.h
+ * @brief Server-Sent Events push channel for the status frame.
+ * @details A subscriber's connection is kept open after its request
+ *          returns. A frame is written to it only when its content differs
+ *          from the last frame that subscriber received, so an idle
+ *          dashboard costs nothing but a periodic keep-alive comment.
+ */
+
+#ifndef EVENT_STREAM_H
+#define EVENT_STREAM_H
+
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include "AppConfig.h"
+
+/**
+ * @brief Builds the frame for one subscriber.
+ * @param sensor Sensor index the subscriber asked for.
+ * @param buf Destination buffer.
+ * @param size Size of `buf`.
+ * @return Length of the frame.
+ */
+typedef int (*EventFrameBuilder)(uint8_t sensor, char *buf, size_t size);
+
+/**
+ * @brief Takes over a client connection as an event-stream subscriber.
+ * @param client Connection of the current request.
+ * @param sensor Sensor index the frames should describe.
+ * @return false if all SSE_MAX_CLIENTS slots are taken.
+ */
+bool eventsSubscribe(WiFiClient client, uint8_t sensor);
+
+/**
+ * @brief Sends changed frames and keep-alives and drops closed connections.
+ * @param nowMs Current millis().
+ * @param build Frame builder.
+ */
+void eventsPoll(unsigned long nowMs, EventFrameBuilder build);
+
+/**
+ * @brief Number of connected subscribers.
+ */
+uint8_t eventsSubscribers();
+
+#endif // EVENT_STREAM_H
@@ -0,0 +1,101 @@
+/**
+ * @file FixedPoint.cpp
+ * @brief Implementation of the centi-degree helpers.
+ */
+
+#include "FixedPoint.h"
+
+int16_t rawToCenti(int16_t raw) {
+    int32_t scaled = (int32_t)raw * 100;
+    return (int16_t)(scaled >= 0 ? (scaled + 64) / 128 : (scaled - 64) / 128);
+}
+
+int formatCenti(char *out, int32_t centi, uint8_t decimals) {
+    char *p = out;
+    uint32_t mag;
+    if (centi < 0) {
+        *p++ = '-';
+        mag = (uint32_t)(-(int64_t)centi);
+    } else {
+        mag = (uint32_t)centi;
+    }
+    if (decimals == 1) mag = (mag + 5) / 10;
+    uint32_t scale = decimals == 1 ? 10 : 100;
+
+    // Integer part, written backwards into a scratch buffer.
+    char digits[10];
+    int n = 0;
+    uint32_t whole = mag / scale;
+    do {
+        digits[n++] = (char)('0' + whole % 10);
+        whole /= 10;
+    } while (whole > 0);
+    while (n > 0) *p++ = digits[--n];
+
+    uint32_t frac = mag % scale;
+    *p++ = '.';
+    if (decimals != 1) *p++ = (char)('0' + frac / 10);
+    *p++ = (char)('0' + frac % 10);
+    *p = '\0';
+
+    // "-0.0" reads oddly; drop the sign when the rounded value is zero.
+    if (out[0] == '-' && mag == 0) {
+        memmove(out, out + 1, p - out);
+        p--;
+    }
+    return p - out;
+}
+
+int16_t parseCenti(const char *text) {
+    const char *p = text;
+    while (*p == ' ') p++;
+    bool negative = *p == '-';
+    if (*p == '-' || *p == '+') p++;
+
+    int32_t value = 0;
+    int digits = 0;
+    while (*p >= '0' && *p <= '9') {
+        value = value * 10 + (*p++ - '0');
+        digits++;
+        if (value > 99999) return INT16_MIN;
+    }
+    value *= 100;
+
+    if (*p == '.') {
+        p++;
+        int32_t place = 10;
+        while (*p >= '0' && *p <= '9') {
+            if (place > 0) value += (*p - '0') * place;
+            else if (place == 0 && *p >= '5') value++;
+            place = place > 1 ? place / 10 : place - 1;
+            p++;
+            digits++;
+        }
+    }
+    while (*p == ' ' || *p == '\r' || *p == '\n') p++;
+    if (digits == 0 || *p != '\0') return INT16_MIN;
+    if (negative) value = -value;
+    if (value <= INT16_MIN || value > INT16_MAX) return INT16_MIN;
+    return (int16_t)value;
+}
+
+int32_t divRound(int64_t num, int64_t den) {
+    if ((num < 0) != (den < 0)) return (int32_t)((num - den / 2) / den);
+    return (int32_t)((num + den / 2) / den);
+}
+
+uint32_t isqrt64(uint64_t value) {
+    uint64_t root = 0;
+    uint64_t bit = 1ULL << 62;
+    while (bit > value) bit >>= 2;
+    while (bit != 0) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)root;
+}
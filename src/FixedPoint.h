@@ -0,0 +1,46 @@
+/**
+ * @file FixedPoint.h
+ * @brief Centi-degree fixed-point helpers.
+ * @details Temperatures are carried as int16_t hundredths of a degree from
+ *          the sensor read through storage, binning and JSON output, so no
+ *          path touches soft-float or the float printf/strtod code.
+ */
+
+#ifndef FIXED_POINT_H
+#define FIXED_POINT_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Converts a DallasTemperature raw reading (1/128 degree) to
+ *        centi-degrees, rounding half away from zero.
+ */
+int16_t rawToCenti(int16_t raw);
+
+/**
+ * @brief Writes centi-degrees as a decimal number, e.g. -105 -> "-1.05".
+ * @param out Destination; needs at most 9 bytes including the terminator.
+ * @param centi Value in centi-degrees.
+ * @param decimals 1 (rounded to tenths) or 2.
+ * @return Characters written, excluding the terminator.
+ */
+int formatCenti(char *out, int32_t centi, uint8_t decimals = 2);
+
+/**
+ * @brief Parses a decimal number ("25", "-3.5", "24.75") into
+ *        centi-degrees. Digits past the second decimal are rounded.
+ * @return The value, or INT16_MIN if `text` is not a number or out of range.
+ */
+int16_t parseCenti(const char *text);
+
+/**
+ * @brief Integer division rounded half away from zero.
+ */
+int32_t divRound(int64_t num, int64_t den);
+
+/**
+ * @brief Floor of the square root of a non-negative 64-bit integer.
+ */
+uint32_t isqrt64(uint64_t value);
+
+#endif // FIXED_POINT_H
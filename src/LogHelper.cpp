@@ -4,93 +4,1162 @@
  */
 
 #include "LogHelper.h"
+#include "LogStore.h"
+#include "Rollup.h"
+#include "TimeIndex.h"
+#include "FixedPoint.h"
+#include "Metrics.h"
 
-String getHistoryJson(int mode, long now) {
-    long period = (mode == 1) ? 3600 : (mode == 2) ? 86400 : 2592000;
-    long bin = (mode == 1) ? 300 : (mode == 2) ? 3600 : 86400;
+static const uint32_t META_MAGIC = 0x4154454D; // "META"
 
-    File f = LittleFS.open(LOG_FILE_PATH, "r");
-    if (!f) return "[]";
+// Preallocated single-file rings of earlier firmware, taken over on boot
+static const char *const LEGACY_STORE_PATH = "/log%u.bin";
+static const char *const LEGACY_INDEX_PATH = "/log%u.idx";
+static const char *const LEGACY_ROLLUP_PATHS[3] = {"/roll5m%u.bin", "/roll1h%u.bin", "/roll1d%u.bin"};
+
+/**
+ * @brief Retry state after a failed write: nothing is attempted before
+ *        `retryMs`, and the delay doubles with every failure in a row.
+ */
+struct Backoff {
+    uint8_t failures;
+    unsigned long retryMs;
+};
 
-    DynamicJsonDocument doc(4096);
-    JsonArray arr = doc.to<JsonArray>();
+/**
+ * @brief Everything stored for one sensor: raw ring, rollup tiers and
+ *        summary.
+ */
+struct SensorLog {
+    bool open;
+    RingLog ring;
+    TimeIndex index;      ///< Hour buckets -> sequence numbers in ring
+    DayArchive archive;   ///< Sealed days, kept after they leave the ring
+    RollupTier tiers[3];  ///< Indexed by history mode - 1 (5-minute, hourly, daily)
+    LogMeta meta;         ///< Includes staged samples; persisted every LOG_META_INTERVAL
+    uint32_t metaSaved;   ///< meta.lastTime when the summary was last persisted
+    LogRecord staged[LOG_FLUSH_SAMPLES];
+    uint8_t stagedCount;
+    int16_t limits[2];    ///< Green and yellow limits in centi-degrees, for the tier counts
+    bool sealing;         ///< A day is being copied into the archive
+    uint32_t sealSeq;     ///< Sequence number of the next record to copy
+    uint32_t sealEnd;     ///< End of the day being sealed
+    Backoff writeRetry;   ///< Failed opens and flushes
+    Backoff tierRetry;    ///< Failed tier flushes
+    Backoff sealRetry;    ///< Failed archive seals
+};
+
+static SensorLog logs[MAX_SENSORS];
+static uint8_t logSlots = MAX_SENSORS;  ///< Sensors whose logs fit on the filesystem
+static uint32_t fsUsable = 0;       ///< Flash available to the logs; 0 if unknown
+static uint32_t sensorBytes = 0;    ///< Flash one sensor's rings can take (see sensorFootprint())
 
-    float sum = 0;
-    int count = 0;
-    long lastBin = -1;
-    long binTime = 0;
+#if LOG_RTC_BACKUP
+static const uint32_t RTC_MAGIC = 0x47545352; // "RSTG"
 
+/**
+ * @brief Copy of every staging buffer kept in user RTC memory, which
+ *        survives a watchdog or software reset (but not a power loss).
+ */
+struct __attribute__((aligned(4))) RtcStaging {
+    uint32_t magic;
+    uint32_t checksum;
+    uint8_t counts[MAX_SENSORS];
+    LogRecord records[MAX_SENSORS][LOG_FLUSH_SAMPLES];
+};
+
+static_assert(sizeof(RtcStaging) <= 512, "Staging buffers do not fit in user RTC memory");
+
+static uint32_t stagingChecksum(const RtcStaging &rtc) {
+    const uint8_t *p = (const uint8_t *)rtc.counts;
+    size_t len = sizeof(RtcStaging) - offsetof(RtcStaging, counts);
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static void saveStaging() {
+    RtcStaging rtc = {};
+    rtc.magic = RTC_MAGIC;
+    for (uint8_t s = 0; s < MAX_SENSORS; s++) {
+        rtc.counts[s] = logs[s].stagedCount;
+        memcpy(rtc.records[s], logs[s].staged, logs[s].stagedCount * sizeof(LogRecord));
+    }
+    rtc.checksum = stagingChecksum(rtc);
+    ESP.rtcUserMemoryWrite(0, (uint32_t *)&rtc, sizeof(rtc));
+}
+#else
+static void saveStaging() {}
+#endif
+
+/**
+ * @brief Alarm level of a sample against the sensor's limits.
+ */
+static uint8_t sampleLevel(const SensorLog &log, int16_t centi) {
+    if (centi > log.limits[1]) return 2;
+    if (centi > log.limits[0]) return 1;
+    return 0;
+}
+
+static void sensorPath(char *out, size_t size, const char *pattern, uint8_t sensor) {
+    snprintf(out, size, pattern, (unsigned)sensor);
+}
+
+/**
+ * @brief Records the outcome of a write; after a failure the next attempt
+ *        waits LOG_RETRY_MIN_MS, doubling up to LOG_RETRY_MAX_MS.
+ * @return `ok`.
+ */
+static bool noteResult(Backoff &retry, bool ok) {
+    if (ok) {
+        retry.failures = 0;
+        return true;
+    }
+    if (retry.failures < 16) retry.failures++;
+    uint32_t delay = LOG_RETRY_MIN_MS << (retry.failures - 1);
+    if (delay > LOG_RETRY_MAX_MS) delay = LOG_RETRY_MAX_MS;
+    retry.retryMs = millis() + delay;
+    return false;
+}
+
+static bool retryPending(const Backoff &retry) {
+    return retry.failures > 0 && (long)(millis() - retry.retryMs) < 0;
+}
+
+/**
+ * @brief Flash one sensor's log can take at most, archive excluded: its
+ *        full rings, the metadata pair of its directory and the summary.
+ */
+static uint32_t sensorFootprint(uint32_t blockSize) {
+    return RingLog::footprint(sizeof(LogRecord), LOG_CAPACITY) +
+           RingLog::footprint(sizeof(IndexEntry), LOG_INDEX_CAPACITY) +
+           RingLog::footprint(sizeof(RollupRecord), ROLLUP_5M_CAPACITY) +
+           RingLog::footprint(sizeof(RollupRecord), ROLLUP_1H_CAPACITY) +
+           RingLog::footprint(sizeof(RollupRecord), ROLLUP_1D_CAPACITY) + 3 * blockSize;
+}
+
+static void saveMeta(uint8_t sensor) {
+    char path[32];
+    sensorPath(path, sizeof(path), LOG_META_PATH, sensor);
+    File f = LittleFS.open(path, "w");
+    if (f) {
+        f.write((const uint8_t *)&logs[sensor].meta, sizeof(LogMeta));
+        f.close();
+    }
+    logs[sensor].metaSaved = logs[sensor].meta.lastTime;
+}
+
+static void resetMeta(LogMeta &meta) {
+    meta = {};
+    meta.magic = META_MAGIC;
+    meta.minCenti = INT16_MAX;
+    meta.maxCenti = INT16_MIN;
+}
+
+/**
+ * @brief Loads the persisted summary and catches it up with the records
+ *        appended since it was written; rebuilds it with one pass over the
+ *        ring if it is missing or its last record is no longer there.
+ */
+static void loadMeta(uint8_t sensor) {
+    SensorLog &log = logs[sensor];
+    LogMeta &meta = log.meta;
+    char path[32];
+    sensorPath(path, sizeof(path), LOG_META_PATH, sensor);
+
+    File f = LittleFS.open(path, "r");
+    bool ok = f && f.read((uint8_t *)&meta, sizeof(meta)) == sizeof(meta) && meta.magic == META_MAGIC;
+    if (f) f.close();
+    // Timestamps only increase, so the records after the summary's last
+    // one are the ones it is missing.
+    uint32_t from = 0;
+    LogRecord rec;
+    if (ok && meta.count > 0) {
+        from = log.ring.lowerBound(meta.lastTime);
+        ok = log.ring.read(from, &rec, 1) == 1 && rec.timestamp == meta.lastTime;
+        from++;
+    } else if (ok) {
+        ok = meta.written == 0;
+    }
+    if (!ok) {
+        resetMeta(meta);
+        from = 0;
+    }
+
+    LogRecord chunk[32];
+    uint32_t index = from;
+    size_t n;
+    while ((n = log.ring.read(index, chunk, 32)) > 0) {
+        index += n;
+        for (size_t i = 0; i < n; i++) {
+            if (chunk[i].centi < meta.minCenti) meta.minCenti = chunk[i].centi;
+            if (chunk[i].centi > meta.maxCenti) meta.maxCenti = chunk[i].centi;
+        }
+        meta.lastTime = chunk[n - 1].timestamp;
+        yield();
+    }
+    uint32_t added = log.ring.count() - from;
+    meta.written = ok ? meta.written + added : log.ring.count();
+    meta.count = log.ring.count();
+    meta.bytes = meta.count * sizeof(LogRecord);
+    if (meta.count > 0 && log.ring.read(0, &rec, 1) == 1) meta.firstTime = rec.timestamp;
+    if (added > 0 || !ok) saveMeta(sensor);
+    else log.metaSaved = meta.lastTime;
+}
+
+/**
+ * @brief Renames the single-sensor files of earlier firmware to the
+ *        sensor 0 names.
+ */
+static void migrateLegacyPaths() {
+    static const char *const legacy[][2] = {
+        {"/log.bin", LEGACY_STORE_PATH},
+        {"/log.meta", LOG_META_PATH},
+        {"/roll5m.bin", LEGACY_ROLLUP_PATHS[0]},
+        {"/roll1h.bin", LEGACY_ROLLUP_PATHS[1]},
+        {"/roll1d.bin", LEGACY_ROLLUP_PATHS[2]},
+    };
+    char path[32];
+    for (const auto &entry : legacy) {
+        sensorPath(path, sizeof(path), entry[1], 0);
+        if (LittleFS.exists(entry[0]) && !LittleFS.exists(path)) LittleFS.rename(entry[0], path);
+    }
+}
+
+/**
+ * @brief Converts a legacy "timestamp,temp" text log into the sensor 0
+ *        ring and removes it.
+ */
+static void migrateTextLog() {
+    File f = LittleFS.open(LOG_FILE_PATH, "r");
+    if (!f) return;
+
+    char line[32];
+    LogRecord chunk[32];
+    size_t n = 0;
     while (f.available()) {
-        String line = f.readStringUntil('\n');
-        int commaPos = line.indexOf(',');
-        if (commaPos == -1) continue;
-
-        long t = line.substring(0, commaPos).toInt();
-        float temp = line.substring(commaPos + 1).toFloat();
-
-        if (t > (now - period)) {
-        long currentBin = t / bin;
-        if (lastBin == -1) { lastBin = currentBin; binTime = t; }
-
-        if (currentBin != lastBin) {
-            if (count > 0) {
-            JsonObject obj = arr.createNestedObject();
-            DateTime dt((uint32_t)binTime);
-            if (mode == 1) obj["l"] = String(dt.hour()) + ":" + (dt.minute() < 10 ? "0" : "") + String(dt.minute());
-            else if (mode == 2) obj["l"] = String(dt.hour()) + ":00";
-            else obj["l"] = String(dt.day()) + "/" + String(dt.month());
-            
-            obj["f"] = String(dt.year()) + "/" + String(dt.month()) + "/" + String(dt.day()) + " " + 
-                        String(dt.hour()) + ":" + String(dt.minute());
-            obj["t"] = sum / count;
-            }
-            sum = 0; count = 0; lastBin = currentBin; binTime = t;
+        size_t len = f.readBytesUntil('\n', line, sizeof(line) - 1);
+        line[len] = '\0';
+        char *comma = strchr(line, ',');
+        if (comma == nullptr) continue;
+
+        *comma = '\0';
+        LogRecord &rec = chunk[n];
+        rec.timestamp = (uint32_t)atol(line);
+        rec.centi = parseCenti(comma + 1);
+        if (rec.centi == INT16_MIN) continue;
+        if (++n == 32) {
+            logs[0].ring.append(chunk, n);
+            n = 0;
+        }
+        yield();
+    }
+    if (n > 0) logs[0].ring.append(chunk, n);
+    f.close();
+    LittleFS.remove(LOG_FILE_PATH);
+}
+
+/**
+ * @brief Takes over a preallocated ring file of earlier firmware, if one
+ *        is left.
+ */
+static void migrateRing(RingLog &ring, const char *legacyPattern, uint8_t sensor) {
+    char path[32];
+    sensorPath(path, sizeof(path), legacyPattern, sensor);
+    if (LittleFS.exists(path)) ring.migrate(path);
+}
+
+/**
+ * @brief Sequence number of the oldest record still in the ring.
+ */
+static uint32_t oldestSeq(SensorLog &log) {
+    return log.meta.written - log.ring.count();
+}
+
+/**
+ * @brief Checks the newest index entry against the ring and rebuilds the
+ *        index with one pass over the ring if it is missing or stale.
+ */
+static void loadIndex(SensorLog &log) {
+    IndexEntry entry;
+    LogRecord rec[2];
+    bool ok = false;
+    uint32_t at = 0;
+    if (log.ring.count() == 0) {
+        ok = !log.index.last(entry);
+    } else if (log.index.last(entry) && entry.seq >= oldestSeq(log) && entry.seq < log.meta.written) {
+        // The entry must point at the first record of its bucket.
+        at = entry.seq - oldestSeq(log);
+        uint32_t from = at > 0 ? at - 1 : 0;
+        size_t n = log.ring.read(from, rec, at - from + 1);
+        const LogRecord &hit = rec[at - from];
+        ok = n == at - from + 1 && hit.timestamp >= entry.start && hit.timestamp - entry.start < LOG_INDEX_BUCKET &&
+             (at == 0 || rec[0].timestamp < entry.start);
+    }
+    // A valid index only misses the entries that were still staged at a
+    // reset; they are added again from the records after its last one.
+    if (!ok) log.index.clear();
+    LogRecord chunk[32];
+    uint32_t index = ok ? at : 0;
+    size_t n;
+    while ((n = log.ring.read(index, chunk, 32)) > 0) {
+        for (size_t i = 0; i < n; i++) log.index.add(chunk[i].timestamp, oldestSeq(log) + index + i);
+        index += n;
+        yield();
+    }
+}
+
+/**
+ * @brief Returns the logical ring index of the first record at or after
+ *        `timestamp`.
+ * @details Jumps to the record the hour index points at and scans the rest
+ *          of that bucket; falls back to a binary search over the whole
+ *          ring when the bucket is no longer covered by the index.
+ */
+static uint32_t findRecord(SensorLog &log, uint32_t timestamp) {
+    uint32_t seq;
+    if (!log.index.lookup(timestamp, seq) || seq < oldestSeq(log)) return log.ring.lowerBound(timestamp);
+
+    LogRecord chunk[32];
+    uint32_t index = seq - oldestSeq(log);
+    size_t n;
+    while ((n = log.ring.read(index, chunk, 32)) > 0) {
+        for (size_t i = 0; i < n; i++) {
+            if (chunk[i].timestamp >= timestamp) return index + i;
         }
-        sum += temp; count++;
+        index += n;
+    }
+    return index;
+}
+
+/**
+ * @brief Appends the staged closed bins of the tiers holding at least
+ *        `minBins` of them.
+ * @details Bins that fail to be written stay staged and are retried with
+ *          the same backoff as a failed flush of the ring.
+ */
+static bool flushTiers(SensorLog &log, uint8_t minBins) {
+    if (retryPending(log.tierRetry)) return false;
+    bool ok = true;
+    for (int i = 0; i < 3; i++) {
+        if (log.tiers[i].staged() >= minBins) ok = log.tiers[i].flush() && ok;
+    }
+    return noteResult(log.tierRetry, ok);
+}
+
+/**
+ * @brief Feeds raw samples that are not yet covered by a closed bin back
+ *        into the tiers. Restores the open bins after a reboot and fully
+ *        rebuilds a tier whose file was missing.
+ */
+static void replayTiers(SensorLog &log) {
+    uint32_t resume[3];
+    uint32_t from = UINT32_MAX;
+    for (int i = 0; i < 3; i++) {
+        resume[i] = log.tiers[i].resumeFrom();
+        if (resume[i] < from) from = resume[i];
+    }
+
+    LogRecord chunk[32];
+    uint32_t index = findRecord(log, from);
+    size_t n;
+    while ((n = log.ring.read(index, chunk, 32)) > 0) {
+        index += n;
+        for (size_t i = 0; i < n; i++) {
+            uint8_t level = sampleLevel(log, chunk[i].centi);
+            for (int k = 0; k < 3; k++) {
+                if (chunk[i].timestamp < resume[k]) continue;
+                // A rebuilt tier closes more bins than staging holds
+                if (log.tiers[k].staged() == ROLLUP_STAGED_BINS) flushTiers(log, ROLLUP_FLUSH_BINS);
+                log.tiers[k].add(chunk[i].timestamp, chunk[i].centi, level);
+            }
         }
         yield();
     }
+}
+
+/**
+ * @brief Writes the staged samples of one sensor to flash in one batch.
+ * @details Tiers are written once ROLLUP_FLUSH_BINS bins are staged and
+ *          the summary every LOG_META_INTERVAL; both are restored from the
+ *          ring after a reset.
+ * @return false if the ring could not be written; the samples stay staged
+ *         and the next attempt waits for the retry delay.
+ */
+static bool flushSensor(uint8_t sensor) {
+    SensorLog &log = logs[sensor];
+    if (log.stagedCount == 0) return true;
+    if (!noteResult(log.writeRetry, log.ring.append(log.staged, log.stagedCount))) return false;
+    for (uint8_t i = 0; i < log.stagedCount; i++) log.index.add(log.staged[i].timestamp, log.meta.written + i);
+    flushTiers(log, ROLLUP_FLUSH_BINS);
+    log.meta.written += log.stagedCount;
+    log.stagedCount = 0;
+    if (log.meta.lastTime - log.metaSaved >= LOG_META_INTERVAL) saveMeta(sensor);
+    return true;
+}
+
+/**
+ * @brief Stages one sample and feeds it to the tiers and the summary.
+ * @param tiersFrom Per tier, the first timestamp it still takes; nullptr
+ *        feeds every tier.
+ */
+static void stageSample(uint8_t sensor, const LogRecord &rec, const uint32_t *tiersFrom) {
+    SensorLog &log = logs[sensor];
+    LogMeta &meta = log.meta;
 
-    if (count > 0) {
-        JsonObject obj = arr.createNestedObject();
-        DateTime dt((uint32_t)binTime);
-        if (mode == 1) obj["l"] = String(dt.hour()) + ":" + (dt.minute() < 10 ? "0" : "") + String(dt.minute());
-        else if (mode == 2) obj["l"] = String(dt.hour()) + ":00";
-        else obj["l"] = String(dt.day()) + "/" + String(dt.month());
-        
-        obj["f"] = String(dt.year()) + "/" + String(dt.month()) + "/" + String(dt.day()) + " " + 
-                String(dt.hour()) + ":" + String(dt.minute());
-        obj["t"] = sum / count;
+    log.staged[log.stagedCount++] = rec;
+    uint8_t level = sampleLevel(log, rec.centi);
+    for (int i = 0; i < 3; i++) {
+        if (tiersFrom == nullptr || rec.timestamp >= tiersFrom[i]) log.tiers[i].add(rec.timestamp, rec.centi, level);
     }
 
-    f.close();
-    String out;
-    serializeJson(doc, out);
-    return out;
+    // Once ring plus staging exceed the capacity, the oldest record is
+    // the first one that will survive the next flush.
+    uint32_t total = log.ring.count() + log.stagedCount;
+    uint32_t capacity = log.ring.capacity();
+    if (meta.count == 0) meta.firstTime = rec.timestamp;
+    else if (total > capacity) {
+        uint32_t skip = total - capacity;
+        LogRecord oldest;
+        if (skip < log.ring.count()) {
+            if (log.ring.read(skip, &oldest, 1) == 1) meta.firstTime = oldest.timestamp;
+        } else {
+            meta.firstTime = log.staged[skip - log.ring.count()].timestamp;
+        }
+    }
+    meta.count = total > capacity ? capacity : total;
+    meta.bytes = meta.count * sizeof(LogRecord);
+    meta.lastTime = rec.timestamp;
+    if (rec.centi < meta.minCenti) meta.minCenti = rec.centi;
+    if (rec.centi > meta.maxCenti) meta.maxCenti = rec.centi;
+
+    if (log.stagedCount == LOG_FLUSH_SAMPLES) flushSensor(sensor);
+    saveStaging();
+    RingLog::release();
 }
 
-void appendLog(long timestamp, float temp) {
-    File f = LittleFS.open(LOG_FILE_PATH, "a");
-    if (f) {
-        f.printf("%ld,%.2f\n", timestamp, temp);
-        f.close();
+/**
+ * @brief Opens (creating if needed) every file of one sensor.
+ * @details A log that fails to open is retried with the same backoff as a
+ *          failed flush, not on every sample.
+ */
+static bool openSensorLog(uint8_t sensor) {
+    SensorLog &log = logs[sensor];
+    if (log.open) return true;
+    if (sensor >= logSlots || retryPending(log.writeRetry)) return false;
+
+    char path[32];
+    sensorPath(path, sizeof(path), LOG_STORE_PATH, sensor);
+    if (!noteResult(log.writeRetry, log.ring.begin(path, sizeof(LogRecord), LOG_CAPACITY))) return false;
+    migrateRing(log.ring, LEGACY_STORE_PATH, sensor);
+    if (sensor == 0) migrateTextLog();
+    loadMeta(sensor);
+    // The index is rebuilt from the ring rather than taken over
+    sensorPath(path, sizeof(path), LEGACY_INDEX_PATH, sensor);
+    LittleFS.remove(path);
+    sensorPath(path, sizeof(path), LOG_INDEX_PATH, sensor);
+    log.index.begin(path, LOG_INDEX_BUCKET, LOG_INDEX_CAPACITY);
+    loadIndex(log);
+
+    sensorPath(path, sizeof(path), ROLLUP_5M_PATH, sensor);
+    log.tiers[0].begin(path, 300, ROLLUP_5M_CAPACITY);
+    sensorPath(path, sizeof(path), ROLLUP_1H_PATH, sensor);
+    log.tiers[1].begin(path, 3600, ROLLUP_1H_CAPACITY);
+    sensorPath(path, sizeof(path), ROLLUP_1D_PATH, sensor);
+    log.tiers[2].begin(path, 86400, ROLLUP_1D_CAPACITY);
+    for (int i = 0; i < 3; i++) migrateRing(log.tiers[i].closed(), LEGACY_ROLLUP_PATHS[i], sensor);
+    replayTiers(log);
+    sensorPath(path, sizeof(path), LOG_ARCHIVE_PATH, sensor);
+    log.archive.begin(path);
+    RingLog::release();
+
+    log.open = true;
+    return true;
+}
+
+void logSetLimits(uint8_t sensor, const SensorLimits &limits) {
+    if (sensor >= MAX_SENSORS) return;
+    logs[sensor].limits[0] = limits.green;
+    logs[sensor].limits[1] = limits.yellow;
+}
+
+bool logBegin(uint8_t sensors) {
+    migrateLegacyPaths();
+    if (sensors == 0) sensors = 1;
+    // Only as many sensors are logged as fit with every ring full; opening
+    // more would run the filesystem full once their rings fill up. The
+    // root directory's metadata pair is not available to them.
+    FSInfo info;
+    if (LittleFS.info(info)) {
+        uint32_t usable = info.totalBytes > 2 * info.blockSize ? info.totalBytes - 2 * info.blockSize : 0;
+        uint32_t fit = usable / sensorFootprint(info.blockSize);
+        logSlots = fit < MAX_SENSORS ? (uint8_t)fit : MAX_SENSORS;
+        fsUsable = usable;
+        sensorBytes = sensorFootprint(info.blockSize);
+    }
+    bool ok = sensors <= logSlots;
+    for (uint8_t i = 0; i < sensors && i < MAX_SENSORS; i++) ok = openSensorLog(i) && ok;
+
+#if LOG_RTC_BACKUP
+    // Samples staged before a reset are appended again as if they had just arrived.
+    RtcStaging rtc;
+    if (ESP.rtcUserMemoryRead(0, (uint32_t *)&rtc, sizeof(rtc)) &&
+        rtc.magic == RTC_MAGIC && rtc.checksum == stagingChecksum(rtc)) {
+        for (uint8_t s = 0; s < MAX_SENSORS; s++) {
+            if (rtc.counts[s] == 0 || !openSensorLog(s)) continue;
+            // Bins that closed while these samples were staged are already
+            // in the tiers; the samples only go into the bins still open.
+            uint32_t resume[3];
+            for (int k = 0; k < 3; k++) resume[k] = logs[s].tiers[k].resumeFrom();
+            for (uint8_t i = 0; i < rtc.counts[s] && i < LOG_FLUSH_SAMPLES; i++) {
+                // Already on flash if the reset hit between a flush and the RTC update.
+                if (logs[s].meta.count > 0 && rtc.records[s][i].timestamp <= logs[s].meta.lastTime) continue;
+                stageSample(s, rtc.records[s][i], resume);
+            }
+        }
+    }
+    saveStaging();
+#endif
+    return ok;
+}
+
+void logFlush() {
+    for (uint8_t s = 0; s < MAX_SENSORS; s++) {
+        SensorLog &log = logs[s];
+        if (!log.open || !flushSensor(s)) continue;
+        flushTiers(log, 1);
+        log.index.flush();
+        saveMeta(s);
+    }
+    saveStaging();
+}
+
+void logEnd() {
+    for (uint8_t s = 0; s < MAX_SENSORS; s++) {
+        // Everything but the limits, which are set before logBegin()
+        int16_t limits[2] = {logs[s].limits[0], logs[s].limits[1]};
+        logs[s] = SensorLog();
+        memcpy(logs[s].limits, limits, sizeof(limits));
+    }
+}
+
+/**
+ * @brief Drops the oldest archive files, largest archive first, until the
+ *        archives plus one more day fit next to the full rings of every
+ *        open log, so a seal does not fail on a full filesystem.
+ * @details A sensor that is opened later shrinks the space of the
+ *          archives; its rings take a month to fill, and the next seal
+ *          makes room for them.
+ */
+static void makeArchiveRoom() {
+    if (fsUsable == 0) return;
+    for (;;) {
+        uint32_t rings = 0, archives = 0;
+        DayArchive *largest = nullptr;
+        for (SensorLog &log : logs) {
+            if (!log.open) continue;
+            rings += sensorBytes;
+            archives += log.archive.bytes();
+            if (largest == nullptr || log.archive.bytes() > largest->bytes()) largest = &log.archive;
+        }
+        if (rings + archives + LOG_ARCHIVE_RESERVE <= fsUsable || largest == nullptr || !largest->dropOldest()) return;
+    }
+}
+
+/**
+ * @brief Copies the next ARCHIVE_SLICE_RECORDS records of the day being
+ *        sealed into its segment, and seals it once the day is complete.
+ * @details Records are tracked by sequence number, so appends between
+ *          passes do not shift the position.
+ */
+static void sealStep(SensorLog &log) {
+    if (log.sealSeq < oldestSeq(log)) log.sealSeq = oldestSeq(log);
+    LogRecord chunk[32];
+    uint16_t read = 0;
+    size_t n = 0;
+    bool inDay = true;
+    while (inDay && read < ARCHIVE_SLICE_RECORDS && (n = log.ring.read(log.sealSeq - oldestSeq(log), chunk, 32)) > 0) {
+        read += n;
+        for (size_t i = 0; i < n && inDay; i++) {
+            inDay = chunk[i].timestamp < log.sealEnd;
+            if (inDay) {
+                log.archive.add(chunk[i]);
+                log.sealSeq++;
+            }
+        }
+    }
+    if (inDay && n > 0) return;
+    log.sealing = false;
+    noteResult(log.sealRetry, log.archive.seal());
+}
+
+bool logArchive() {
+    for (uint8_t s = 0; s < MAX_SENSORS; s++) {
+        SensorLog &log = logs[s];
+        uint32_t count = log.ring.count();
+        if (!log.open || count == 0) continue;
+
+        if (!log.sealing) {
+            if (retryPending(log.sealRetry)) continue;
+            LogRecord newest, rec;
+            uint32_t index = findRecord(log, log.archive.nextDay() * 86400);
+            if (index >= count || log.ring.read(count - 1, &newest, 1) != 1 || log.ring.read(index, &rec, 1) != 1) continue;
+            // Days without samples are skipped; the newest day is still open.
+            uint32_t day = rec.timestamp / 86400;
+            if (day >= newest.timestamp / 86400) continue;
+            makeArchiveRoom();
+            if (!noteResult(log.sealRetry, log.archive.open(day))) continue;
+            log.sealing = true;
+            log.sealSeq = oldestSeq(log) + index;
+            log.sealEnd = (day + 1) * 86400;
+        }
+        sealStep(log);
+        RingLog::release();
+        return true;
+    }
+    RingLog::release();
+    return false;
+}
+
+/**
+ * @brief Appends `,"name":value` with the value in degrees.
+ */
+static int jsonCenti(char *out, const char *name, int32_t centi) {
+    char *p = out;
+    *p++ = ',';
+    *p++ = '"';
+    while (*name) *p++ = *name++;
+    *p++ = '"';
+    *p++ = ':';
+    return (p - out) + formatCenti(p, centi);
+}
+
+/**
+ * @brief Axis label of a bin: time of day for the 1 h and 1 day views,
+ *        day/month for the 30 day view.
+ */
+static void binLabel(char *label, size_t size, int mode, const DateTime &dt) {
+    if (mode == 1) snprintf(label, size, "%d:%02d", dt.hour(), dt.minute());
+    else if (mode == 2) snprintf(label, size, "%d:00", dt.hour());
+    else snprintf(label, size, "%d/%d", dt.day(), dt.month());
+}
+
+/**
+ * @brief Writes one finished bin as a JSON object.
+ */
+static void writeHistoryBin(Print &out, int mode, const RollupRecord &rec, bool first, bool stats) {
+    DateTime dt(rec.start);
+    char label[8];
+    binLabel(label, sizeof(label), mode, dt);
+
+    char buf[160];
+    int len = snprintf(buf, sizeof(buf), "%s{\"l\":\"%s\",\"f\":\"%d/%d/%d %d:%d\"",
+                       first ? "" : ",", label, dt.year(), dt.month(), dt.day(), dt.hour(), dt.minute());
+    len += jsonCenti(buf + len, "t", divRound(rec.sum, rec.count));
+    if (stats) {
+        len += jsonCenti(buf + len, "mn", rec.min);
+        len += jsonCenti(buf + len, "mx", rec.max);
+        len += jsonCenti(buf + len, "sd", rollupStdDev(rec));
+        len += snprintf(buf + len, sizeof(buf) - len, ",\"n\":%u,\"g\":%u,\"y\":%u",
+                        rec.count, rec.above[0], rec.above[1]);
+    }
+    buf[len++] = '}';
+    out.write((const uint8_t *)buf, len);
+}
+
+/**
+ * @brief Bin length of a history mode in seconds.
+ */
+static long historyBin(int mode) {
+    return (mode == 1) ? 300 : (mode == 2) ? 3600 : 86400;
+}
+
+/**
+ * @brief Start of the oldest bin shown by a history mode.
+ */
+static uint32_t historyFrom(int mode, long now) {
+    long period = (mode == 1) ? 3600 : (mode == 2) ? 86400 : 2592000;
+    // A bin is shown if any part of it lies inside the requested period.
+    long from = now - period - historyBin(mode) + 1;
+    return from > 0 ? (uint32_t)from : 0;
+}
+
+void historyBegin(HistoryCursor &cur, uint8_t sensor, int mode, long now, bool stats) {
+    cur.sensor = sensor;
+    cur.mode = mode;
+    cur.stats = stats;
+    cur.first = true;
+    cur.stage = 0;
+    cur.from = historyFrom(mode, now);
+    cur.next = cur.from;
+}
+
+bool historyStep(HistoryCursor &cur, Print &out, uint16_t maxBins) {
+    METRIC_SCOPE(METRIC_HISTORY);
+    bool open = cur.sensor < MAX_SENSORS && logs[cur.sensor].open;
+    if (cur.stage == 0) {
+        out.write('[');
+        cur.stage = open ? 1 : 2;
+    }
+    if (cur.stage == 2 || !open) {
+        out.write(']');
+        cur.stage = 3;
+    }
+    if (cur.stage == 3) return false;
+
+    RollupTier &tier = logs[cur.sensor].tiers[(cur.mode == 1) ? 0 : (cur.mode == 2) ? 1 : 2];
+
+    // Re-locate by time so bins closed or dropped between slices are handled.
+    RollupRecord chunk[16];
+    uint32_t index = tier.lowerBound(cur.next);
+    uint16_t written = 0;
+    while (written < maxBins) {
+        size_t n = tier.read(index, chunk, 16);
+        if (n == 0) break;
+        index += n;
+        for (size_t i = 0; i < n; i++) {
+            cur.next = chunk[i].start + 1;
+            if (chunk[i].count == 0) continue;
+            writeHistoryBin(out, cur.mode, chunk[i], cur.first, cur.stats);
+            cur.first = false;
+            written++;
+        }
+    }
+    if (written >= maxBins) return true;
+
+    if (tier.hasOpen() && tier.open().start >= cur.next) writeHistoryBin(out, cur.mode, tier.open(), cur.first, cur.stats);
+    out.write(']');
+    cur.stage = 3;
+    RingLog::release();
+    return false;
+}
+
+void writeHistoryJson(uint8_t sensor, int mode, long now, bool stats, Print &out) {
+    HistoryCursor cur;
+    historyBegin(cur, sensor, mode, now, stats);
+    while (historyStep(cur, out, 16)) yield();
+}
+
+// --- SVG chart ---
+
+static const uint8_t CHART_MAX_POINTS = 32;  // 31 daily bins of the 30 day view plus the open one
+static const int CHART_W = 600;
+static const int CHART_H = 260;
+static const int CHART_LEFT = 40;            // Room for the temperature labels
+static const int CHART_RIGHT = 590;
+static const int CHART_TOP = 10;
+static const int CHART_BOTTOM = 236;         // Room for the time labels below
+
+/**
+ * @brief What the chart keeps of one bin.
+ */
+struct ChartPoint {
+    uint32_t start;
+    int16_t avg;
+    int16_t min;
+    int16_t max;
+    int16_t sd;
+    uint16_t count;
+    uint16_t above[2];
+};
+
+/**
+ * @brief Maps times and centi-degrees to chart pixels.
+ */
+struct ChartScale {
+    uint32_t from;
+    uint32_t span;
+    uint32_t halfBin;
+    int32_t lo;
+    int32_t hi;
+
+    int x(uint32_t start) const {
+        uint32_t t = start + halfBin - from;
+        if (t > span) t = span;
+        return CHART_LEFT + (int)((uint64_t)t * (CHART_RIGHT - CHART_LEFT) / span);
+    }
+    int y(int32_t centi) const {
+        return CHART_BOTTOM - (int)((int64_t)(centi - lo) * (CHART_BOTTOM - CHART_TOP) / (hi - lo));
+    }
+};
+
+static void addChartPoint(ChartPoint *points, uint8_t &count, const RollupRecord &rec) {
+    if (rec.count == 0) return;
+    // More bins than expected (clock set back): keep the newest.
+    if (count == CHART_MAX_POINTS) {
+        memmove(points, points + 1, sizeof(ChartPoint) * (CHART_MAX_POINTS - 1));
+        count--;
+    }
+    ChartPoint &p = points[count++];
+    p.start = rec.start;
+    p.avg = (int16_t)divRound(rec.sum, rec.count);
+    p.min = rec.min;
+    p.max = rec.max;
+    p.sd = rollupStdDev(rec);
+    p.count = rec.count;
+    p.above[0] = rec.above[0];
+    p.above[1] = rec.above[1];
+}
+
+/**
+ * @brief Writes "x,y " without going through printf (coordinates are
+ *        small non-negative integers).
+ */
+static void writePoint(Print &out, int x, int y) {
+    char buf[12];
+    char *p = buf + sizeof(buf);
+    *--p = ' ';
+    do { *--p = (char)('0' + y % 10); y /= 10; } while (y > 0);
+    *--p = ',';
+    do { *--p = (char)('0' + x % 10); x /= 10; } while (x > 0);
+    out.write((const uint8_t *)p, buf + sizeof(buf) - p);
+}
+
+/**
+ * @brief Rounds `v` down (`up` false) or up to a multiple of `step`.
+ */
+static int32_t roundToStep(int32_t v, int32_t step, bool up) {
+    int32_t q = v / step;
+    if (up ? (v > q * step) : (v < q * step)) q += up ? 1 : -1;
+    return q * step;
+}
+
+void writeHistorySvg(uint8_t sensor, int mode, long now, Print &out) {
+    ChartScale scale;
+    scale.from = historyFrom(mode, now);
+    scale.halfBin = historyBin(mode) / 2;
+    scale.span = (uint32_t)(now - (long)scale.from) + 1;
+
+    // The same walk over the rollup tier as historyStep(), into a fixed array
+    ChartPoint points[CHART_MAX_POINTS];
+    uint8_t count = 0;
+    if (sensor < MAX_SENSORS && logs[sensor].open) {
+        RollupTier &tier = logs[sensor].tiers[(mode == 1) ? 0 : (mode == 2) ? 1 : 2];
+        RollupRecord chunk[8];
+        uint32_t index = tier.lowerBound(scale.from);
+        size_t n;
+        while ((n = tier.read(index, chunk, 8)) > 0) {
+            index += n;
+            for (size_t i = 0; i < n; i++) addChartPoint(points, count, chunk[i]);
+        }
+        if (tier.hasOpen() && tier.open().start >= scale.from) addChartPoint(points, count, tier.open());
+        RingLog::release();
+    }
+
+    out.printf("<svg xmlns=\"http://www.w3.org/2000/svg\" viewBox=\"0 0 %d %d\" font-family=\"sans-serif\" font-size=\"11\">"
+               "<style>text{fill:#555}.grid{stroke:#e5e5e5}.lim{stroke-dasharray:6 4}.g{stroke:#ffc107}.y{stroke:#dc3545}"
+               ".band{fill:rgba(220,53,69,.15)}.avg{fill:none;stroke:#007bff;stroke-width:2}"
+               "circle{fill:#007bff}circle.g{fill:#ffc107}circle.y{fill:#dc3545}</style>",
+               CHART_W, CHART_H);
+    if (count == 0) {
+        out.printf("<text x=\"%d\" y=\"%d\" text-anchor=\"middle\">No data</text></svg>", CHART_W / 2, CHART_H / 2);
+        return;
+    }
+
+    // Whole-degree grid with at most 6 lines
+    int32_t lo = points[0].min, hi = points[0].max;
+    for (uint8_t i = 1; i < count; i++) {
+        if (points[i].min < lo) lo = points[i].min;
+        if (points[i].max > hi) hi = points[i].max;
+    }
+    int32_t step = 100 * ((hi - lo + 499) / 500);
+    if (step == 0) step = 100;
+    scale.lo = roundToStep(lo, step, false);
+    scale.hi = roundToStep(hi, step, true);
+    if (scale.hi == scale.lo) scale.hi += step;
+
+    char value[12];
+    for (int32_t v = scale.lo; v <= scale.hi; v += step) {
+        int y = scale.y(v);
+        formatCenti(value, v, 1);
+        out.printf("<line class=\"grid\" x1=\"%d\" y1=\"%d\" x2=\"%d\" y2=\"%d\"/>"
+                   "<text x=\"%d\" y=\"%d\" text-anchor=\"end\">%s</text>",
+                   CHART_LEFT, y, CHART_RIGHT, y, CHART_LEFT - 4, y + 4, value);
+    }
+    // Limits in force now, where they fall inside the plotted range
+    for (uint8_t l = 0; l < 2; l++) {
+        int32_t v = logs[sensor].limits[l];
+        if (v < scale.lo || v > scale.hi) continue;
+        int y = scale.y(v);
+        out.printf("<line class=\"lim %s\" x1=\"%d\" y1=\"%d\" x2=\"%d\" y2=\"%d\"/>", l ? "y" : "g",
+                   CHART_LEFT, y, CHART_RIGHT, y);
+    }
+
+    // Min/max envelope: along the maxima, back along the minima
+    out.print("<polygon class=\"band\" points=\"");
+    for (uint8_t i = 0; i < count; i++) writePoint(out, scale.x(points[i].start), scale.y(points[i].max));
+    for (uint8_t i = count; i-- > 0;) writePoint(out, scale.x(points[i].start), scale.y(points[i].min));
+    out.print("\"/><polyline class=\"avg\" points=\"");
+    for (uint8_t i = 0; i < count; i++) writePoint(out, scale.x(points[i].start), scale.y(points[i].avg));
+    out.print("\"/>");
+
+    // One marker per bin, coloured by the highest limit crossed, with the
+    // bin statistics as its tooltip
+    char avg[12], sd[12], mn[12], mx[12], label[8];
+    for (uint8_t i = 0; i < count; i++) {
+        const ChartPoint &p = points[i];
+        DateTime dt(p.start);
+        formatCenti(avg, p.avg, 1);
+        formatCenti(sd, p.sd, 1);
+        formatCenti(mn, p.min, 1);
+        formatCenti(mx, p.max, 1);
+        out.printf("<circle class=\"%s\" cx=\"%d\" cy=\"%d\" r=\"%d\"><title>%d/%d/%d %d:%02d\n%s \xC2\xB1 %s (%s \xE2\x80\xA6 %s)\n"
+                   "&gt; green %u/%u, &gt; yellow %u/%u</title></circle>",
+                   p.above[1] ? "y" : p.above[0] ? "g" : "n", scale.x(p.start), scale.y(p.avg), p.above[1] ? 5 : 3,
+                   dt.year(), dt.month(), dt.day(), dt.hour(), dt.minute(), avg, sd, mn, mx,
+                   p.above[0], p.count, p.above[1], p.count);
     }
+
+    // Time labels under the first, middle and last bin
+    uint8_t marks[3] = {0, (uint8_t)(count / 2), (uint8_t)(count - 1)};
+    for (uint8_t m = 0; m < 3; m++) {
+        if (m > 0 && marks[m] == marks[m - 1]) continue;
+        binLabel(label, sizeof(label), mode, DateTime(points[marks[m]].start));
+        out.printf("<text x=\"%d\" y=\"%d\" text-anchor=\"middle\">%s</text>",
+                   scale.x(points[marks[m]].start), CHART_H - 8, label);
+    }
+    out.print("</svg>");
+}
+
+/**
+ * @brief Writes one export row or record.
+ */
+static void writeExportRow(Print &out, bool binary, bool binned, const ExportBin &row) {
+    if (binary) {
+        if (binned) {
+            out.write((const uint8_t *)&row, sizeof(row));
+        } else {
+            LogRecord rec = {row.start, row.avg};
+            out.write((const uint8_t *)&rec, sizeof(rec));
+        }
+        return;
+    }
+
+    char buf[48];
+    int len = snprintf(buf, sizeof(buf), "%lu,", (unsigned long)row.start);
+    len += formatCenti(buf + len, row.avg);
+    if (binned) {
+        buf[len++] = ',';
+        len += formatCenti(buf + len, row.min);
+        buf[len++] = ',';
+        len += formatCenti(buf + len, row.max);
+    }
+    buf[len++] = '\n';
+    out.write((const uint8_t *)buf, len);
+}
+
+void exportBegin(ExportCursor &cur, uint8_t sensor, uint32_t from, uint32_t to, uint32_t step, bool binary) {
+    cur = {};
+    cur.sensor = sensor;
+    cur.from = from;
+    cur.to = to;
+    cur.step = step;
+    cur.binary = binary;
+    cur.done = sensor >= MAX_SENSORS || !logs[sensor].open || from > to;
+    if (cur.done) return;
+
+    SensorLog &log = logs[sensor];
+    flushSensor(sensor);
+    saveStaging();
+    // The archive cannot be read while a segment is open
+    while (log.sealing) sealStep(log);
+    cur.archiveEnd = log.ring.count() > 0 ? log.meta.firstTime : UINT32_MAX;
+    cur.archived = from < cur.archiveEnd && log.archive.rewind(cur.arc, from);
+    if (!cur.archived) cur.seq = oldestSeq(log) + findRecord(log, from);
+}
+
+/**
+ * @brief Emits the pending downsampled bin, if any.
+ */
+static void closeExportBin(ExportCursor &cur, Print &out) {
+    if (cur.n == 0) return;
+    cur.row.avg = (int16_t)divRound(cur.sum, cur.n);
+    writeExportRow(out, cur.binary, true, cur.row);
+    cur.rows++;
+    cur.n = 0;
+}
+
+/**
+ * @brief Writes one record as a row, or adds it to the current bin.
+ */
+static void exportRecord(ExportCursor &cur, Print &out, const LogRecord &rec) {
+    if (cur.step == 0) {
+        cur.row.start = rec.timestamp;
+        cur.row.avg = rec.centi;
+        writeExportRow(out, cur.binary, false, cur.row);
+        cur.rows++;
+        return;
+    }
+
+    uint32_t start = rec.timestamp - rec.timestamp % cur.step;
+    if (cur.n > 0 && start != cur.row.start) closeExportBin(cur, out);
+    if (cur.n == 0) {
+        cur.row.start = start;
+        cur.row.min = rec.centi;
+        cur.row.max = rec.centi;
+        cur.sum = 0;
+    }
+    cur.sum += rec.centi;
+    cur.n++;
+    if (rec.centi < cur.row.min) cur.row.min = rec.centi;
+    if (rec.centi > cur.row.max) cur.row.max = rec.centi;
+}
+
+/**
+ * @brief Exports from the day archive until the ring takes over, then
+ *        positions the cursor in the ring.
+ */
+static void exportArchived(ExportCursor &cur, Print &out, uint16_t maxRecords) {
+    SensorLog &log = logs[cur.sensor];
+    LogRecord chunk[32];
+    uint16_t read = 0;
+    size_t got = 1;
+    while (cur.archived && !cur.done && read < maxRecords) {
+        got = log.archive.read(cur.arc, cur.from, chunk, 32);
+        read += got;
+        for (size_t i = 0; i < got; i++) {
+            if (chunk[i].timestamp > cur.to) {
+                cur.done = true;
+                break;
+            }
+            if (chunk[i].timestamp >= cur.archiveEnd) {
+                got = 0;
+                break;
+            }
+            exportRecord(cur, out, chunk[i]);
+        }
+        if (got == 0) cur.archived = false;
+    }
+    if (!cur.archived) {
+        log.archive.release();
+        uint32_t from = cur.from > cur.archiveEnd ? cur.from : cur.archiveEnd;
+        cur.seq = oldestSeq(log) + findRecord(log, from);
+    }
+}
+
+bool exportStep(ExportCursor &cur, Print &out, uint16_t maxRecords) {
+    METRIC_SCOPE(METRIC_EXPORT);
+    if (!cur.header) {
+        if (!cur.binary) out.print(cur.step > 0 ? "time,avg,min,max\n" : "time,temp\n");
+        cur.header = true;
+    }
+    if (cur.done) return false;
+
+    if (cur.archived) {
+        // A seal started between slices; the archive task finishes it
+        if (logs[cur.sensor].sealing) return true;
+        exportArchived(cur, out, maxRecords);
+        if (!cur.done) return true;
+        closeExportBin(cur, out);
+        exportEnd(cur);
+        return false;
+    }
+
+    SensorLog &log = logs[cur.sensor];
+    // Sequence numbers survive appends between slices; records that wrapped
+    // away in the meantime are skipped.
+    if (cur.seq < oldestSeq(log)) cur.seq = oldestSeq(log);
+
+    LogRecord chunk[32];
+    uint16_t read = 0;
+    size_t got = 0;
+    while (!cur.done && read < maxRecords && (got = log.ring.read(cur.seq - oldestSeq(log), chunk, 32)) > 0) {
+        read += got;
+        for (size_t i = 0; i < got; i++) {
+            if (chunk[i].timestamp > cur.to) {
+                cur.done = true;
+                break;
+            }
+            cur.seq++;
+            exportRecord(cur, out, chunk[i]);
+        }
+    }
+    if (got == 0) cur.done = true;
+    if (!cur.done) return true;
+
+    closeExportBin(cur, out);
+    exportEnd(cur);
+    return false;
+}
+
+void exportEnd(ExportCursor &cur) {
+    cur.done = true;
+    if (cur.sensor < MAX_SENSORS) logs[cur.sensor].archive.release();
+    RingLog::release();
+}
+
+uint32_t writeExport(uint8_t sensor, uint32_t from, uint32_t to, uint32_t step, bool binary, Print &out) {
+    ExportCursor cur;
+    exportBegin(cur, sensor, from, to, step, binary);
+    while (exportStep(cur, out, 64)) yield();
+    return cur.rows;
+}
+
+/**
+ * @brief Drops every record of one open log, including its day archive.
+ */
+static void clearSensor(uint8_t sensor) {
+    SensorLog &log = logs[sensor];
+    log.stagedCount = 0;
+    log.writeRetry = {};
+    log.tierRetry = {};
+    log.sealRetry = {};
+    log.sealing = false;
+    log.ring.clear();
+    log.index.clear();
+    for (int i = 0; i < 3; i++) log.tiers[i].clear();
+    log.archive.clear();
+    resetMeta(log.meta);
+    saveMeta(sensor);
+}
+
+void appendLog(uint8_t sensor, long timestamp, int16_t centi) {
+    METRIC_SCOPE(METRIC_APPEND_LOG);
+    if (sensor >= MAX_SENSORS || !openSensorLog(sensor)) return;
+    SensorLog &log = logs[sensor];
+    // Lookups, the tiers and the archive rely on timestamps that only
+    // increase. After the clock was set back, samples are dropped until it
+    // passes the last one logged; the history itself is kept.
+    if (log.meta.count > 0 && (uint32_t)timestamp <= log.meta.lastTime) return;
+    // After a failed flush the staging buffer stays full; samples are
+    // dropped until the retry is due.
+    if (log.stagedCount == LOG_FLUSH_SAMPLES && (retryPending(log.writeRetry) || !flushSensor(sensor))) return;
+    LogRecord rec;
+    rec.timestamp = (uint32_t)timestamp;
+    rec.centi = centi;
+    stageSample(sensor, rec, nullptr);
+}
+
+void clearSensorLog(uint8_t sensor) {
+    if (sensor >= MAX_SENSORS || !openSensorLog(sensor)) return;
+    clearSensor(sensor);
+    saveStaging();
 }
 
 void clearLogFile() {
-    LittleFS.remove(LOG_FILE_PATH);
+    for (uint8_t s = 0; s < MAX_SENSORS; s++) {
+        if (logs[s].open) clearSensor(s);
     }
+    saveStaging();
+    LittleFS.remove(LOG_FILE_PATH);
+}
 
-    void getLogStats(int &lines, int &size) {
+void getLogStats(int &lines, int &size) {
+    METRIC_SCOPE(METRIC_LOG_STATS);
     lines = 0;
     size = 0;
-    File f = LittleFS.open(LOG_FILE_PATH, "r");
-    if (f) {
-        size = f.size();
-        while (f.available()) {
-        f.readStringUntil('\n');
-        lines++;
-        }
-        f.close();
+    for (uint8_t s = 0; s < MAX_SENSORS; s++) {
+        if (!logs[s].open) continue;
+        lines += (int)logs[s].meta.count;
+        size += (int)logs[s].meta.bytes;
     }
-}
\ No newline at end of file
+}
+
+const LogMeta &getLogMeta(uint8_t sensor) {
+    static LogMeta empty = {};
+    if (sensor >= MAX_SENSORS || !logs[sensor].open) return empty;
+    return logs[sensor].meta;
+}
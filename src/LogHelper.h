@@ -9,34 +9,242 @@
 #include <Arduino.h>
 #include <LittleFS.h>
 #include <RTClib.h>
-#include <ArduinoJson.h>
 #include "AppConfig.h"
+#include "DayArchive.h"
 
 /**
- * @brief Generates a JSON string for the history chart.
- * * @param mode Time range mode (1: 1 Hour, 2: 1 Day, 3: 30 Days).
+ * @brief Summary of the log kept up to date on every append and clear.
+ */
+struct LogMeta {
+    uint32_t magic;
+    uint32_t count;       ///< Records currently stored
+    uint32_t bytes;       ///< Payload bytes currently stored
+    uint32_t firstTime;   ///< Timestamp of the oldest stored record
+    uint32_t lastTime;    ///< Timestamp of the newest stored record
+    int16_t minCenti;     ///< Lowest value since the last clear (centi-degrees)
+    int16_t maxCenti;     ///< Highest value since the last clear (centi-degrees)
+    uint32_t written;     ///< Records flushed to the ring since the last clear (index sequence numbers)
+};
+
+/**
+ * @brief Sets the limits used to count samples above green and yellow in
+ *        each history bin.
+ * @details Call before logBegin() so bins rebuilt at boot use them too.
+ *          Bins already closed keep the counts they were built with.
+ */
+void logSetLimits(uint8_t sensor, const SensorLimits &limits);
+
+/**
+ * @brief Opens the per-sensor logs and migrates legacy files if present.
+ * @details Must be called once after LittleFS.begin(). Logs of sensors that
+ *          are discovered later are opened on their first append. Sensors
+ *          beyond the number whose full logs fit on the filesystem are not
+ *          logged. A log that fails to open or flush is retried after
+ *          LOG_RETRY_MIN_MS, doubling up to LOG_RETRY_MAX_MS.
+ * @param sensors Number of sensor slots in use (see sensorSlots()).
+ * @return false if not every sensor can be logged.
+ */
+bool logBegin(uint8_t sensors);
+
+/**
+ * @brief Position of a history response that is written in slices.
+ */
+struct HistoryCursor {
+    uint8_t sensor;
+    int8_t mode;
+    bool stats;
+    bool first;       ///< No bin written yet
+    uint8_t stage;    ///< 0 not started, 1 closed bins, 2 closing, 3 done
+    uint32_t from;    ///< Oldest bin start included
+    uint32_t next;    ///< Bins starting before this were already written
+};
+
+/**
+ * @brief Prepares a history response; see writeHistoryJson() for the
+ *        arguments.
+ */
+void historyBegin(HistoryCursor &cur, uint8_t sensor, int mode, long now, bool stats);
+
+/**
+ * @brief Writes the next slice of a history response.
+ * @param maxBins Bins to write before returning (approximate: whole chunks
+ *        of 16 are processed).
+ * @return true while there is more to write.
+ */
+bool historyStep(HistoryCursor &cur, Print &out, uint16_t maxBins);
+
+/**
+ * @brief Streams the history chart data as a JSON array.
+ * @details Each bin is written as soon as it is read, so memory use does
+ *          not depend on the number of bins.
+ * * @param sensor Sensor index.
+ * @param mode Time range mode (1: 1 Hour, 2: 1 Day, 3: 30 Days).
+ * @param now Current timestamp.
+ * @param stats Adds min ("mn"), max ("mx"), standard deviation ("sd"),
+ *        sample count ("n") and samples above green ("g") and yellow ("y")
+ *        to every bin.
+ * @param out Destination for the JSON text.
+ */
+void writeHistoryJson(uint8_t sensor, int mode, long now, bool stats, Print &out);
+
+/**
+ * @brief Renders the history chart as a self-contained SVG image.
+ * @details Reads the same rollup bins as writeHistoryJson() into a fixed
+ *          array of at most 32 points and draws the average line, the
+ *          min/max envelope, the current green and yellow limits and one
+ *          marker per bin. A marker is coloured by the highest limit that
+ *          samples in its bin crossed and carries the bin statistics as a
+ *          tooltip. The image needs no script and no external resources.
+ * @param sensor Sensor index.
+ * @param mode Time range mode (1: 1 Hour, 2: 1 Day, 3: 30 Days).
  * @param now Current timestamp.
- * @return String JSON representation of the data.
+ * @param out Destination for the SVG text.
+ */
+void writeHistorySvg(uint8_t sensor, int mode, long now, Print &out);
+
+/**
+ * @brief One downsampled bin of a binary export (little-endian, packed).
+ */
+struct __attribute__((packed)) ExportBin {
+    uint32_t start;   ///< Bin start, aligned to the step
+    int16_t avg;      ///< Centi-degrees
+    int16_t min;
+    int16_t max;
+};
+
+/**
+ * @brief Position of an export that is written in slices.
+ * @details Reads the day archive up to the oldest record the ring held at
+ *          exportBegin(), then tracks the next ring record by sequence
+ *          number, so appends (and ring wrap-around) between slices do not
+ *          shift it.
  */
-String getHistoryJson(int mode, long now);
+struct ExportCursor {
+    uint8_t sensor;
+    bool binary;
+    bool header;      ///< CSV header written
+    bool done;
+    bool archived;    ///< Still reading the day archive
+    uint32_t from;
+    uint32_t to;
+    uint32_t archiveEnd;  ///< Records from here on are read from the ring
+    ArchiveCursor arc;
+    uint32_t step;
+    uint32_t seq;     ///< Sequence number of the next record to read
+    uint32_t rows;    ///< Rows or records written so far
+    ExportBin row;    ///< Bin being accumulated (downsampled exports)
+    int64_t sum;
+    uint32_t n;
+};
 
 /**
- * @brief Appends a new temperature reading to the log file.
- * * @param timestamp Unix timestamp.
- * @param temp Temperature value.
+ * @brief Prepares an export and flushes staged samples; see writeExport()
+ *        for the arguments.
  */
-void appendLog(long timestamp, float temp);
+void exportBegin(ExportCursor &cur, uint8_t sensor, uint32_t from, uint32_t to, uint32_t step, bool binary);
 
 /**
- * @brief Clears the log file.
+ * @brief Writes the next slice of an export.
+ * @param maxRecords Raw records to read before returning (rounded up to
+ *        whole chunks of 32).
+ * @return true while there is more to write.
+ */
+bool exportStep(ExportCursor &cur, Print &out, uint16_t maxRecords);
+
+/**
+ * @brief Closes the files of an export that stops before exportStep()
+ *        returned false (the client went away).
+ */
+void exportEnd(ExportCursor &cur);
+
+/**
+ * @brief Streams raw log records of one sensor in a time range.
+ * @details Staged samples are flushed first. Records older than the
+ *          ring are decoded from the day archive, skipping whole days that
+ *          end before `from`; the rest are read from the ring in small
+ *          fixed chunks, starting at the seek index entry of `from`. Both
+ *          are written to `out` as they are read.
+ *
+ *          CSV output starts with a header row: "time,temp" for raw
+ *          records, "time,avg,min,max" when downsampled. Binary output is
+ *          a sequence of packed LogRecord (raw) or ExportBin entries.
+ * * @param sensor Sensor index.
+ * @param from First timestamp included.
+ * @param to Last timestamp included.
+ * @param step Downsampling bin width in seconds (0 exports every record).
+ * @param binary true for packed binary records, false for CSV.
+ * @param out Destination for the export.
+ * @return Number of rows or records written.
+ */
+uint32_t writeExport(uint8_t sensor, uint32_t from, uint32_t to, uint32_t step, bool binary, Print &out);
+
+/**
+ * @brief Appends a new temperature reading to a sensor's log.
+ * @details The sample is visible in history and statistics at once but is
+ *          only written to flash with the next batch. A timestamp not after
+ *          the last one logged (the clock was set back) is dropped; the log
+ *          is kept as it is.
+ * * @param sensor Sensor index.
+ * @param timestamp Unix timestamp.
+ * @param centi Temperature in centi-degrees.
+ */
+void appendLog(uint8_t sensor, long timestamp, int16_t centi);
+
+/**
+ * @brief Writes every staged sample and closed rollup bin to flash.
+ * @details Appends are collected in RAM and written LOG_FLUSH_SAMPLES at a
+ *          time, closed bins ROLLUP_FLUSH_BINS per tier, and the summary
+ *          every LOG_META_INTERVAL; call this before reading the raw log
+ *          directly or before a planned restart.
+ */
+void logFlush();
+
+/**
+ * @brief Closes every sensor log without flushing, as a reset would.
+ * @details Staged samples are dropped from RAM but stay in RTC memory, so
+ *          the next logBegin() restores them the same way it does after a
+ *          watchdog reset.
+ */
+void logEnd();
+
+/**
+ * @brief Copies the next slice of the oldest complete day of raw samples
+ *        that is not in the day archive yet.
+ * @details A day is complete once the ring holds a later sample. One call
+ *          copies at most ARCHIVE_SLICE_RECORDS records of one sensor and
+ *          seals the segment after the day's last one, so a day takes
+ *          several scheduler passes and a backlog is worked off one day
+ *          after the other. Exports of the archive wait while a segment is
+ *          open. Before a day is started, the oldest archive files are
+ *          dropped until the archives fit in the flash the rings leave
+ *          free (see logBegin()); a seal that fails anyway is retried with
+ *          the same backoff as a failed flush.
+ * @return true while a seal is in progress or more days may be pending.
+ */
+bool logArchive();
+
+/**
+ * @brief Drops every logged record of every sensor, including the day
+ *        archive.
  */
 void clearLogFile();
 
 /**
- * @brief Gets basic file statistics (line count and file size).
- * * @param lines Reference to store line count.
- * @param size Reference to store file size (bytes).
+ * @brief Drops every logged record of one sensor, including its day
+ *        archive (its slot went to a different probe).
+ */
+void clearSensorLog(uint8_t sensor);
+
+/**
+ * @brief Gets basic log statistics summed over all sensors.
+ * * @param lines Reference to store record count.
+ * @param size Reference to store used payload size (bytes).
  */
 void getLogStats(int &lines, int &size);
 
+/**
+ * @brief Returns the persisted log summary of one sensor in O(1).
+ */
+const LogMeta &getLogMeta(uint8_t sensor);
+
 #endif // LOG_HELPER_H
\ No newline at end of file
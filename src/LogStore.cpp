@@ -0,0 +1,331 @@
+/**
+ * @file LogStore.cpp
+ * @brief Implementation of the LittleFS ring buffer.
+ */
+
+#include "LogStore.h"
+#include "AppConfig.h"
+
+static const uint32_t SEGMENT_MAGIC = 0x47455352; // "RSEG"
+static const uint16_t SEGMENT_VERSION = 1;
+static const uint32_t SEGMENT_BYTES = FS_BLOCK_BYTES;
+
+/**
+ * @brief Header of the single preallocated ring file of earlier firmware.
+ */
+struct __attribute__((packed)) LegacyRingHeader {
+    uint32_t magic;     ///< "RLOG"
+    uint16_t version;   ///< 1
+    uint16_t recordSize;
+    uint32_t capacity;
+    uint32_t head;      ///< Slot that receives the next append
+    uint32_t count;
+};
+
+static const uint32_t LEGACY_MAGIC = 0x474F4C52; // "RLOG"
+
+// Read handle shared by every ring, and the segment file it is on
+static File reader;
+static char readerPath[40];
+
+static void releaseIf(const char *prefix) {
+    if (reader && strncmp(readerPath, prefix, strlen(prefix)) == 0) RingLog::release();
+}
+
+void RingLog::release() {
+    reader.close();
+    readerPath[0] = '\0';
+}
+
+SeriesDir::SeriesDir(const char *prefix, const char *ext) : _ext(ext) {
+    const char *slash = strrchr(prefix, '/');
+    _base = slash != nullptr ? slash + 1 : prefix;
+    _baseLen = strlen(_base);
+    char dir[24];
+    int len = slash != nullptr && slash > prefix ? (int)(slash - prefix) : 1;
+    snprintf(dir, sizeof(dir), "%.*s", len, slash != nullptr ? prefix : "/");
+    _dir = LittleFS.openDir(dir);
+}
+
+bool SeriesDir::next(uint32_t &number, size_t &size) {
+    while (_dir.next()) {
+        String name = _dir.fileName();
+        const char *digits = name.c_str() + _baseLen;
+        if (strncmp(name.c_str(), _base, _baseLen) != 0 || !isdigit((unsigned char)*digits)) continue;
+        char *end;
+        unsigned long n = strtoul(digits, &end, 10);
+        if (strcmp(end, _ext) != 0) continue;
+        number = (uint32_t)n;
+        size = _dir.fileSize();
+        return true;
+    }
+    return false;
+}
+
+uint32_t RingLog::footprint(uint16_t recordSize, uint32_t capacity) {
+    uint32_t perSegment = (SEGMENT_BYTES - sizeof(RingSegmentHeader)) / recordSize;
+    return ((capacity + perSegment - 1) / perSegment + 1) * SEGMENT_BYTES;
+}
+
+void RingLog::segmentPath(char *out, size_t size, uint32_t segment) const {
+    snprintf(out, size, "%s%lu.bin", _prefix, (unsigned long)segment);
+}
+
+bool RingLog::begin(const char *prefix, uint16_t recordSize, uint32_t capacity) {
+    strncpy(_prefix, prefix, sizeof(_prefix) - 1);
+    releaseIf(_prefix);
+    _recordSize = recordSize;
+    _capacity = capacity;
+    _perSegment = (SEGMENT_BYTES - sizeof(RingSegmentHeader)) / recordSize;
+    _firstSegment = 0;
+    _segments = 0;
+    _lastCount = 0;
+
+    uint32_t first = UINT32_MAX, last = 0, files = 0, partial = 0, segment;
+    size_t lastSize = 0, size;
+    SeriesDir d(_prefix, ".bin");
+    while (d.next(segment, size)) {
+        if (size != sizeof(RingSegmentHeader) + _perSegment * recordSize) partial++;
+        if (segment < first) first = segment;
+        if (files == 0 || segment >= last) {
+            last = segment;
+            lastSize = size;
+        }
+        files++;
+    }
+    if (files == 0) return true;
+    _firstSegment = first;
+    _segments = last - first + 1;
+
+    // Only the newest file may be partly filled, and none may be missing.
+    bool full = lastSize == sizeof(RingSegmentHeader) + _perSegment * recordSize;
+    bool ok = files == _segments && partial == (full ? 0 : 1);
+    RingSegmentHeader hdr;
+    char path[40];
+    segmentPath(path, sizeof(path), last);
+    File f = LittleFS.open(path, "r+");
+    if (ok && lastSize >= sizeof(hdr)) {
+        ok = f && f.read((uint8_t *)&hdr, sizeof(hdr)) == sizeof(hdr) && hdr.magic == SEGMENT_MAGIC &&
+             hdr.version == SEGMENT_VERSION && hdr.recordSize == recordSize;
+    }
+    if (!ok) {
+        f.close();
+        removeSegments();
+        return true;
+    }
+
+    if (lastSize < sizeof(hdr)) {
+        // Torn while the file was being started: the one before is full.
+        f.close();
+        LittleFS.remove(path);
+        _segments--;
+        _lastCount = _segments > 0 ? _perSegment : 0;
+    } else {
+        _lastCount = (lastSize - sizeof(hdr)) / recordSize;
+        size_t valid = sizeof(hdr) + _lastCount * recordSize;
+        if (valid != lastSize && !f.truncate(valid)) {
+            f.close();
+            removeSegments();
+            return true;
+        }
+        f.close();
+    }
+    trim();
+    return true;
+}
+
+bool RingLog::migrate(const char *legacyPath) {
+    File in = LittleFS.open(legacyPath, "r");
+    if (!in) return false;
+    LegacyRingHeader old;
+    bool valid = in.read((uint8_t *)&old, sizeof(old)) == sizeof(old) && old.magic == LEGACY_MAGIC &&
+                 old.recordSize == _recordSize && old.capacity > 0 && old.head < old.capacity &&
+                 old.count <= old.capacity;
+    bool ok = valid;
+    if (valid) {
+        clear();
+        uint32_t tail = (old.head + old.capacity - old.count) % old.capacity;
+        uint32_t i = old.count > _capacity ? old.count - _capacity : 0;
+        uint8_t buf[256];
+        File out;
+        while (ok && i < old.count) {
+            if (!out || _lastCount == _perSegment) {
+                out.close();
+                out = startSegment();
+                if (!out) { ok = false; break; }
+            }
+            uint32_t slot = (tail + i) % old.capacity;
+            uint32_t run = sizeof(buf) / _recordSize;
+            if (run > old.count - i) run = old.count - i;
+            if (run > old.capacity - slot) run = old.capacity - slot;
+            if (run > _perSegment - _lastCount) run = _perSegment - _lastCount;
+            size_t bytes = run * _recordSize;
+            ok = in.seek(sizeof(old) + (size_t)slot * _recordSize) && in.read(buf, bytes) == bytes &&
+                 out.write(buf, bytes) == bytes;
+            if (ok) _lastCount += run;
+            i += run;
+            yield();
+        }
+        out.close();
+    }
+    in.close();
+    if (ok || !valid) LittleFS.remove(legacyPath);
+    else begin(_prefix, _recordSize, _capacity);
+    return ok;
+}
+
+/**
+ * @brief Creates the next segment file with its header.
+ * @return The file, open for appending records; invalid on failure.
+ */
+File RingLog::startSegment() {
+    char path[40];
+    segmentPath(path, sizeof(path), _firstSegment + _segments);
+    releaseIf(path);
+    File f = LittleFS.open(path, "w");
+    RingSegmentHeader hdr = {SEGMENT_MAGIC, SEGMENT_VERSION, _recordSize};
+    if (f && f.write((const uint8_t *)&hdr, sizeof(hdr)) != sizeof(hdr)) {
+        f.close();
+        LittleFS.remove(path);
+    }
+    if (!f) return f;
+    _segments++;
+    _lastCount = 0;
+    return f;
+}
+
+/**
+ * @brief Removes the oldest segment files while the others still hold
+ *        `capacity` records.
+ */
+void RingLog::trim() {
+    char path[40];
+    while (_segments > 1 && stored() - _perSegment >= _capacity) {
+        segmentPath(path, sizeof(path), _firstSegment);
+        releaseIf(path);
+        LittleFS.remove(path);
+        _firstSegment++;
+        _segments--;
+    }
+}
+
+bool RingLog::append(const void *record) {
+    return append(record, 1);
+}
+
+bool RingLog::append(const void *records, size_t n) {
+    // Only the newest `capacity` records can survive.
+    const uint8_t *src = (const uint8_t *)records;
+    if (n > _capacity) {
+        src += (n - _capacity) * _recordSize;
+        n = _capacity;
+    }
+
+    while (n > 0) {
+        File f;
+        if (_segments == 0 || _lastCount == _perSegment) {
+            f = startSegment();
+        } else {
+            char path[40];
+            segmentPath(path, sizeof(path), _firstSegment + _segments - 1);
+            releaseIf(path);
+            f = LittleFS.open(path, "a");
+        }
+        if (!f) return false;
+
+        size_t run = _perSegment - _lastCount;
+        if (run > n) run = n;
+        size_t bytes = run * _recordSize;
+        bool ok = f.write(src, bytes) == bytes;
+        f.close();
+        if (!ok) {
+            // Rescan, cutting off a partly written record
+            begin(_prefix, _recordSize, _capacity);
+            return false;
+        }
+        _lastCount += run;
+        src += bytes;
+        n -= run;
+    }
+    trim();
+    return true;
+}
+
+/**
+ * @brief Points the shared read handle at one segment file.
+ */
+bool RingLog::openReader(uint32_t segment) {
+    char path[40];
+    segmentPath(path, sizeof(path), segment);
+    if (reader && strcmp(path, readerPath) == 0) return true;
+    reader.close();
+    reader = LittleFS.open(path, "r");
+    strncpy(readerPath, reader ? path : "", sizeof(readerPath) - 1);
+    return (bool)reader;
+}
+
+/**
+ * @brief Reads `n` records starting at stored position `pos` (0 = first
+ *        record of the oldest file).
+ */
+bool RingLog::readStored(uint32_t pos, void *out, size_t n) {
+    uint8_t *dst = (uint8_t *)out;
+    while (n > 0) {
+        uint32_t slot = pos % _perSegment;
+        size_t run = _perSegment - slot;
+        if (run > n) run = n;
+        size_t bytes = run * _recordSize;
+        if (!openReader(_firstSegment + pos / _perSegment) ||
+            !reader.seek(sizeof(RingSegmentHeader) + slot * _recordSize, SeekSet) ||
+            reader.read(dst, bytes) != bytes) {
+            return false;
+        }
+        dst += bytes;
+        pos += run;
+        n -= run;
+    }
+    return true;
+}
+
+size_t RingLog::read(uint32_t index, void *out, size_t n) {
+    uint32_t count = this->count();
+    if (index >= count) return 0;
+    if (n > count - index) n = count - index;
+    return readStored(stored() - count + index, out, n) ? n : 0;
+}
+
+uint32_t RingLog::lowerBound(uint32_t timestamp) {
+    uint32_t lo = 0, hi = count();
+    uint32_t skip = stored() - hi;
+    uint32_t t;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        // Only the leading timestamp of the record is needed.
+        uint32_t pos = skip + mid;
+        if (!openReader(_firstSegment + pos / _perSegment) ||
+            !reader.seek(sizeof(RingSegmentHeader) + (pos % _perSegment) * _recordSize, SeekSet) ||
+            reader.read((uint8_t *)&t, sizeof(t)) != sizeof(t)) break;
+        if (t < timestamp) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+/**
+ * @brief Removes every file of the ring, whatever its number.
+ */
+void RingLog::removeSegments() {
+    releaseIf(_prefix);
+    char path[40];
+    for (uint32_t i = 0; i < _segments; i++) {
+        segmentPath(path, sizeof(path), _firstSegment + i);
+        LittleFS.remove(path);
+    }
+    _firstSegment = 0;
+    _segments = 0;
+    _lastCount = 0;
+}
+
+void RingLog::clear() {
+    removeSegments();
+}
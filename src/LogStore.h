@@ -0,0 +1,157 @@
+/**
+ * @file LogStore.h
+ * @brief Fixed-record ring buffer stored as small append-only segment
+ *        files in a LittleFS directory.
+ * @details Records are appended to the newest segment file, which never
+ *          grows past one LittleFS block; a full one is followed by a new
+ *          file. The oldest file is removed once the newer ones hold
+ *          `capacity` records without it, so flash usage stays between
+ *          `capacity` records and one segment more. No write goes into the
+ *          middle of a file: LittleFS would copy everything behind it, and
+ *          an append only touches the block being filled.
+ *
+ *          Only the newest `capacity` records are visible. Every record
+ *          type stored in a ring must start with a `uint32_t` timestamp;
+ *          this allows time lookups with a binary search.
+ *
+ *          No file is held open between calls except one read handle
+ *          shared by every ring (see release()).
+ */
+
+#ifndef LOG_STORE_H
+#define LOG_STORE_H
+
+#include <Arduino.h>
+#include <LittleFS.h>
+
+/**
+ * @brief One raw temperature sample as stored in the main log.
+ */
+struct __attribute__((packed)) LogRecord {
+    uint32_t timestamp;  ///< Unix timestamp
+    int16_t centi;       ///< Temperature in hundredths of a degree C
+};
+
+/**
+ * @brief On-flash header at offset 0 of every segment file.
+ */
+struct __attribute__((packed)) RingSegmentHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t recordSize;
+};
+
+/**
+ * @brief Lists the files named `<prefix><number><ext>`.
+ * @details LittleFS gives every directory its own metadata pair (two
+ *          blocks), so the files of one sensor share a directory and are
+ *          told apart by the base name in `prefix` ("/log0/raw").
+ */
+class SeriesDir {
+public:
+    SeriesDir(const char *prefix, const char *ext);
+
+    /**
+     * @brief Advances to the next file of the series.
+     * @return false once every file has been listed.
+     */
+    bool next(uint32_t &number, size_t &size);
+
+private:
+    Dir _dir;
+    const char *_base;
+    size_t _baseLen;
+    const char *_ext;
+};
+
+class RingLog {
+public:
+    /**
+     * @brief Scans the segment files of the ring. A torn record at the end
+     *        of the newest file is cut off; files written with a different
+     *        record size are removed.
+     * @param prefix Directory and base name of the segment files; they are
+     *        named `<prefix><number>.bin`.
+     * @param recordSize Size of one record in bytes.
+     * @param capacity Number of records kept.
+     * @return true if the ring is ready for use.
+     */
+    bool begin(const char *prefix, uint16_t recordSize, uint32_t capacity);
+
+    /**
+     * @brief Replaces the contents with the records of a preallocated ring
+     *        file of earlier firmware, then removes that file.
+     * @details The file is kept if the copy fails part way, so the next
+     *          boot tries again.
+     * @return true if records were taken over.
+     */
+    bool migrate(const char *legacyPath);
+
+    /**
+     * @brief Appends one record, dropping the oldest when full.
+     * @param record Pointer to `recordSize` bytes.
+     */
+    bool append(const void *record);
+
+    /**
+     * @brief Appends several records with one write per segment file.
+     * @param records Pointer to `n * recordSize` bytes.
+     * @param n Number of records.
+     */
+    bool append(const void *records, size_t n);
+
+    /**
+     * @brief Reads consecutive records by logical index (0 = oldest).
+     * @param index Logical index of the first record.
+     * @param out Destination buffer, at least `n * recordSize` bytes.
+     * @param n Maximum number of records to read.
+     * @return Number of records actually read.
+     */
+    size_t read(uint32_t index, void *out, size_t n);
+
+    /**
+     * @brief Finds the first record whose timestamp is >= `timestamp`.
+     * @return Logical index, or count() if every record is older.
+     */
+    uint32_t lowerBound(uint32_t timestamp);
+
+    /**
+     * @brief Drops every record and removes the segment files.
+     */
+    void clear();
+
+    /**
+     * @brief Closes the read handle shared by all rings, if one is open.
+     */
+    static void release();
+
+    /**
+     * @brief Flash a ring can take at most: its full segment files plus the
+     *        one being filled and the one that is started before the oldest
+     *        is removed.
+     */
+    static uint32_t footprint(uint16_t recordSize, uint32_t capacity);
+
+    uint32_t count() const { return stored() < _capacity ? stored() : _capacity; }
+    uint32_t capacity() const { return _capacity; }
+    uint16_t recordSize() const { return _recordSize; }
+
+private:
+    uint32_t stored() const { return _segments == 0 ? 0 : (_segments - 1) * _perSegment + _lastCount; }
+    void segmentPath(char *out, size_t size, uint32_t segment) const;
+    File startSegment();
+    bool openReader(uint32_t segment);
+    bool readStored(uint32_t pos, void *out, size_t n);
+    void removeSegments();
+    void trim();
+
+    char _prefix[24] = {0};
+    uint16_t _recordSize = 0;
+    uint32_t _capacity = 0;
+    uint32_t _perSegment = 0;   ///< Records in a full segment file
+    uint32_t _firstSegment = 0; ///< Number of the oldest segment file
+    uint32_t _segments = 0;     ///< Segment files; all but the newest are full
+    uint32_t _lastCount = 0;    ///< Records in the newest segment file
+};
+
+#endif // LOG_STORE_H
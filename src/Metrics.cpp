@@ -0,0 +1,93 @@
+/**
+ * @file Metrics.cpp
+ * @brief Implementation of the probes and the /metrics renderer.
+ */
+
+#include "Metrics.h"
+
+#if METRICS_ENABLED
+
+static const uint8_t BUCKETS = 9;
+static const uint32_t BUCKET_US[BUCKETS - 1] = {50, 200, 1000, 5000, 20000, 100000, 500000, 2000000};
+static const char *const BUCKET_LE[BUCKETS] = {"5e-05", "0.0002", "0.001", "0.005", "0.02", "0.1", "0.5", "2", "+Inf"};
+
+static const char *const FIXED_NAMES[METRIC_FIXED_COUNT] = {
+    "appendLog", "getLogStats", "historyStep", "exportStep", "streamJob", "sensorRead",
+};
+
+struct Probe {
+    const char *name;
+    uint32_t count;
+    uint64_t sumUs;
+    uint32_t maxUs;
+    uint32_t buckets[BUCKETS];  ///< Per bucket, not cumulative
+};
+
+static Probe probes[METRICS_MAX_PROBES];
+static uint8_t probeCount = METRIC_FIXED_COUNT;
+static uint32_t minFreeHeap = UINT32_MAX;
+
+uint8_t metricsRegister(const char *name) {
+    if (probeCount == METRICS_MAX_PROBES) return METRICS_MAX_PROBES;
+    probes[probeCount].name = name;
+    return probeCount++;
+}
+
+void metricsRecord(uint8_t id, uint32_t us) {
+    if (id >= METRICS_MAX_PROBES) return;
+    Probe &p = probes[id];
+    p.count++;
+    p.sumUs += us;
+    if (us > p.maxUs) p.maxUs = us;
+    uint8_t b = 0;
+    while (b < BUCKETS - 1 && us > BUCKET_US[b]) b++;
+    p.buckets[b]++;
+
+    uint32_t heap = ESP.getFreeHeap();
+    if (heap < minFreeHeap) minFreeHeap = heap;
+}
+
+/**
+ * @brief Writes microseconds as seconds with six decimals.
+ */
+static void printSeconds(Print &out, uint64_t us) {
+    out.printf("%lu.%06lu", (unsigned long)(us / 1000000), (unsigned long)(us % 1000000));
+}
+
+void metricsWrite(Print &out) {
+    out.print("# HELP tempmon_probe_duration_seconds Duration of instrumented calls.\n"
+              "# TYPE tempmon_probe_duration_seconds histogram\n");
+    for (uint8_t i = 0; i < probeCount; i++) {
+        const Probe &p = probes[i];
+        const char *name = i < METRIC_FIXED_COUNT ? FIXED_NAMES[i] : p.name;
+        uint32_t cumulative = 0;
+        for (uint8_t b = 0; b < BUCKETS; b++) {
+            cumulative += p.buckets[b];
+            out.printf("tempmon_probe_duration_seconds_bucket{probe=\"%s\",le=\"%s\"} %lu\n",
+                       name, BUCKET_LE[b], (unsigned long)cumulative);
+        }
+        out.printf("tempmon_probe_duration_seconds_sum{probe=\"%s\"} ", name);
+        printSeconds(out, p.sumUs);
+        out.printf("\ntempmon_probe_duration_seconds_count{probe=\"%s\"} %lu\n", name, (unsigned long)p.count);
+    }
+
+    out.print("# HELP tempmon_probe_max_seconds Longest instrumented call since boot.\n"
+              "# TYPE tempmon_probe_max_seconds gauge\n");
+    for (uint8_t i = 0; i < probeCount; i++) {
+        out.printf("tempmon_probe_max_seconds{probe=\"%s\"} ", i < METRIC_FIXED_COUNT ? FIXED_NAMES[i] : probes[i].name);
+        printSeconds(out, probes[i].maxUs);
+        out.print("\n");
+    }
+
+    uint32_t heap = ESP.getFreeHeap();
+    if (heap < minFreeHeap) minFreeHeap = heap;
+    out.printf("# TYPE tempmon_heap_free_bytes gauge\ntempmon_heap_free_bytes %lu\n", (unsigned long)heap);
+    out.printf("# TYPE tempmon_heap_min_free_bytes gauge\ntempmon_heap_min_free_bytes %lu\n", (unsigned long)minFreeHeap);
+    out.printf("# TYPE tempmon_heap_max_block_bytes gauge\ntempmon_heap_max_block_bytes %lu\n",
+               (unsigned long)ESP.getMaxFreeBlockSize());
+    out.printf("# TYPE tempmon_heap_fragmentation_percent gauge\ntempmon_heap_fragmentation_percent %u\n",
+               (unsigned)ESP.getHeapFragmentation());
+    out.printf("# TYPE tempmon_uptime_seconds counter\ntempmon_uptime_seconds %lu\n", millis() / 1000);
+}
+
+#endif // METRICS_ENABLED
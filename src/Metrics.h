@@ -0,0 +1,68 @@
+/**
+ * @file Metrics.h
+ * @brief Compile-time switchable latency probes and heap gauges.
+ * @details A probe counts calls and sorts their duration into a fixed set
+ *          of histogram buckets; it also tracks the lowest free heap seen
+ *          when a probe ends. Everything lives in one static table and is
+ *          rendered as Prometheus text by metricsWrite(). With
+ *          METRICS_ENABLED set to 0 the METRIC_SCOPE() probes compile to
+ *          nothing.
+ */
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <Arduino.h>
+#include "AppConfig.h"
+
+/**
+ * @brief Probes with a fixed slot. Web routes are registered after these.
+ */
+enum MetricId : uint8_t {
+    METRIC_APPEND_LOG,
+    METRIC_LOG_STATS,
+    METRIC_HISTORY,      ///< One history slice (historyStep)
+    METRIC_EXPORT,       ///< One export slice (exportStep)
+    METRIC_STREAM_JOB,   ///< A sliced response from start to last chunk
+    METRIC_SENSOR_READ,
+    METRIC_FIXED_COUNT
+};
+
+/**
+ * @brief Registers a probe for a web route.
+ * @param name Static string used as the probe label.
+ * @return Probe id, or METRICS_MAX_PROBES if the table is full (recording
+ *         to it is a no-op).
+ */
+uint8_t metricsRegister(const char *name);
+
+/**
+ * @brief Adds one call of `us` microseconds to a probe.
+ */
+void metricsRecord(uint8_t id, uint32_t us);
+
+/**
+ * @brief Writes every probe and the heap gauges in Prometheus text format.
+ */
+void metricsWrite(Print &out);
+
+/**
+ * @brief Times the enclosing scope.
+ */
+class MetricScope {
+public:
+    explicit MetricScope(uint8_t id) : _id(id), _start(micros()) {}
+    ~MetricScope() { metricsRecord(_id, micros() - _start); }
+
+private:
+    uint8_t _id;
+    uint32_t _start;
+};
+
+#if METRICS_ENABLED
+#define METRIC_SCOPE(id) MetricScope _metricScope(id)
+#else
+#define METRIC_SCOPE(id) do {} while (0)
+#endif
+
+#endif // METRICS_H
@@ -0,0 +1,105 @@
+/**
+ * @file Rollup.cpp
+ * @brief Implementation of the aggregation tiers.
+ */
+
+#include "Rollup.h"
+#include "FixedPoint.h"
+
+bool RollupTier::begin(const char *path, uint32_t binSeconds, uint32_t capacity) {
+    _binSeconds = binSeconds;
+    _open = {};
+    _stagedCount = 0;
+    return _ring.begin(path, sizeof(RollupRecord), capacity);
+}
+
+uint32_t RollupTier::resumeFrom() {
+    if (_stagedCount > 0) return _staged[_stagedCount - 1].start + _binSeconds;
+    if (_ring.count() == 0) return 0;
+    RollupRecord last;
+    if (_ring.read(_ring.count() - 1, &last, 1) != 1) return 0;
+    return last.start + _binSeconds;
+}
+
+int16_t rollupStdDev(const RollupRecord &rec) {
+    if (rec.count == 0) return 0;
+    // n^2 * variance = n * sum(x^2) - sum(x)^2, exact in 64-bit integers.
+    int64_t scaled = (int64_t)rec.count * (int64_t)rec.sumSq - (int64_t)rec.sum * rec.sum;
+    if (scaled <= 0) return 0;
+    return (int16_t)divRound(isqrt64((uint64_t)scaled), rec.count);
+}
+
+void RollupTier::add(uint32_t timestamp, int16_t centi, uint8_t level) {
+    uint32_t start = timestamp - timestamp % _binSeconds;
+
+    if (_open.count > 0 && start != _open.start) {
+        if (_stagedCount == ROLLUP_STAGED_BINS) {
+            // Not flushed in time (the tier is failing or backing off): the
+            // oldest staged bin gives way.
+            memmove(_staged, _staged + 1, (ROLLUP_STAGED_BINS - 1) * sizeof(RollupRecord));
+            _stagedCount--;
+        }
+        _staged[_stagedCount++] = _open;
+        _open.count = 0;
+    }
+
+    if (_open.count == 0) {
+        _open.start = start;
+        _open.min = centi;
+        _open.max = centi;
+        _open.sum = 0;
+        _open.above[0] = 0;
+        _open.above[1] = 0;
+        _open.sumSq = 0;
+    }
+    if (centi < _open.min) _open.min = centi;
+    if (centi > _open.max) _open.max = centi;
+    if (level >= 1) _open.above[0]++;
+    if (level >= 2) _open.above[1]++;
+    _open.sum += centi;
+    _open.sumSq += (uint32_t)((int32_t)centi * centi);
+    _open.count++;
+}
+
+bool RollupTier::flush() {
+    if (_stagedCount == 0) return true;
+    if (_ring.append(_staged, _stagedCount)) {
+        _stagedCount = 0;
+        return true;
+    }
+    // Keep the bins that did not land; a write that failed part way left
+    // the first ones in the ring.
+    RollupRecord last;
+    uint8_t landed = 0;
+    if (_ring.count() > 0 && _ring.read(_ring.count() - 1, &last, 1) == 1) {
+        while (landed < _stagedCount && _staged[landed].start <= last.start) landed++;
+    }
+    memmove(_staged, _staged + landed, (_stagedCount - landed) * sizeof(RollupRecord));
+    _stagedCount -= landed;
+    return false;
+}
+
+size_t RollupTier::read(uint32_t index, RollupRecord *out, size_t n) {
+    size_t got = 0;
+    uint32_t persisted = _ring.count();
+    if (index < persisted) {
+        got = _ring.read(index, out, n);
+        if (got < n && index + got < persisted) return got;
+    }
+    for (uint32_t i = index + got - persisted; got < n && i < _stagedCount; i++) out[got++] = _staged[i];
+    return got;
+}
+
+uint32_t RollupTier::lowerBound(uint32_t timestamp) {
+    // Staged bins are newer than every persisted one.
+    if (_stagedCount == 0 || _staged[0].start >= timestamp) return _ring.lowerBound(timestamp);
+    uint8_t i = 1;
+    while (i < _stagedCount && _staged[i].start < timestamp) i++;
+    return _ring.count() + i;
+}
+
+void RollupTier::clear() {
+    _ring.clear();
+    _open = {};
+    _stagedCount = 0;
+}
@@ -0,0 +1,110 @@
+/**
+ * @file Rollup.h
+ * @brief Incrementally maintained min/avg/max/stddev aggregation tiers.
+ * @details Each tier keeps one open bin in RAM and closes it once a sample
+ *          from a later bin arrives. Closed bins are staged in RAM as well
+ *          and appended to the tier's ring with the next batched log flush
+ *          (see flush()). History queries then read a few hundred closed
+ *          bins instead of the raw log.
+ */
+
+#ifndef ROLLUP_H
+#define ROLLUP_H
+
+#include <Arduino.h>
+#include "AppConfig.h"
+#include "LogStore.h"
+
+/**
+ * @brief One aggregated bin as stored in a tier file.
+ */
+struct __attribute__((packed)) RollupRecord {
+    uint32_t start;  ///< Unix timestamp of the bin start (aligned to the bin width)
+    int16_t min;     ///< Minimum in centi-degrees
+    int16_t max;     ///< Maximum in centi-degrees
+    int32_t sum;     ///< Sum of samples in centi-degrees
+    uint16_t count;  ///< Number of samples
+    uint16_t above[2];  ///< Samples above the green and yellow limits
+    uint64_t sumSq;  ///< Sum of squared samples in centi-degrees^2 (exact)
+};
+
+/**
+ * @brief Population standard deviation of a bin in centi-degrees.
+ */
+int16_t rollupStdDev(const RollupRecord &rec);
+
+class RollupTier {
+public:
+    /**
+     * @brief Opens the tier ring.
+     * @param path Prefix of the tier's segment files (see RingLog::begin()).
+     * @param binSeconds Bin width in seconds.
+     * @param capacity Number of closed bins kept.
+     */
+    bool begin(const char *path, uint32_t binSeconds, uint32_t capacity);
+
+    /**
+     * @brief Timestamp from which raw samples must be replayed to restore
+     *        the open bin after a reboot (0 if the tier is empty).
+     */
+    uint32_t resumeFrom();
+
+    /**
+     * @brief Adds one sample, closing the open bin if the sample falls
+     *        into a different one.
+     * @param level Alarm level of the sample (0 normal, 1 above green,
+     *        2 above yellow).
+     */
+    void add(uint32_t timestamp, int16_t centi, uint8_t level);
+
+    /**
+     * @brief Appends the staged closed bins to the ring in one write.
+     * @details Called by the log, which backs off after a failure. Bins
+     *          that could not be written stay staged; once
+     *          ROLLUP_STAGED_BINS are waiting, add() drops the oldest.
+     * @return false if the write failed.
+     */
+    bool flush();
+
+    /**
+     * @brief Closed bins waiting for flush().
+     */
+    uint8_t staged() const { return _stagedCount; }
+
+    /**
+     * @brief Closed bins, persisted and staged.
+     */
+    uint32_t count() const { return _ring.count() + _stagedCount; }
+
+    /**
+     * @brief Reads closed bins by index (0 = oldest), the staged ones
+     *        last.
+     * @return Number of bins read.
+     */
+    size_t read(uint32_t index, RollupRecord *out, size_t n);
+
+    /**
+     * @brief Index of the first closed bin starting at or after
+     *        `timestamp`, or count() if none does.
+     */
+    uint32_t lowerBound(uint32_t timestamp);
+
+    /**
+     * @brief Drops all closed bins and the open bin.
+     */
+    void clear();
+
+    uint32_t binSeconds() const { return _binSeconds; }
+    RingLog &closed() { return _ring; }
+    bool hasOpen() const { return _open.count > 0; }
+    const RollupRecord &open() const { return _open; }
+
+private:
+    RingLog _ring;
+    uint32_t _binSeconds = 0;
+    RollupRecord _open = {};
+    RollupRecord _staged[ROLLUP_STAGED_BINS];
+    uint8_t _stagedCount = 0;
+};
+
+#endif // ROLLUP_H
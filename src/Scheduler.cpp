@@ -0,0 +1,94 @@
+/**
+ * @file Scheduler.cpp
+ * @brief Implementation of the cooperative scheduler.
+ */
+
+#include "Scheduler.h"
+
+struct Task {
+    const char *name;
+    TaskFunction fn;
+    uint32_t period;
+    uint32_t deadline;
+    TaskPriority priority;
+    bool pending;            ///< Returned true last time: run again on the next pass
+    unsigned long due;       ///< millis() at which the task becomes due
+    uint32_t runs;
+    uint32_t overruns;
+    uint32_t lastUs;
+    uint32_t maxUs;
+    uint64_t totalUs;
+};
+
+static Task tasks[SCHED_MAX_TASKS];
+static uint8_t taskCount = 0;
+static uint32_t passes = 0;
+static uint32_t maxPassUs = 0;
+
+bool taskAdd(const char *name, TaskFunction fn, uint32_t periodMs, TaskPriority priority, uint32_t deadlineMs) {
+    if (taskCount == SCHED_MAX_TASKS) return false;
+
+    // Keep the table ordered by priority so one scan runs tasks in order.
+    uint8_t at = taskCount;
+    while (at > 0 && tasks[at - 1].priority > priority) {
+        tasks[at] = tasks[at - 1];
+        at--;
+    }
+    tasks[at] = {};
+    tasks[at].name = name;
+    tasks[at].fn = fn;
+    tasks[at].period = periodMs;
+    tasks[at].deadline = deadlineMs;
+    tasks[at].priority = priority;
+    tasks[at].due = millis();
+    taskCount++;
+    return true;
+}
+
+void schedulerRun() {
+    unsigned long passStart = micros();
+    unsigned long nowMs = millis();
+
+    for (uint8_t i = 0; i < taskCount; i++) {
+        Task &task = tasks[i];
+        if (!task.pending && (long)(nowMs - task.due) < 0) continue;
+
+        unsigned long start = micros();
+        task.pending = task.fn(nowMs);
+        uint32_t elapsed = micros() - start;
+        unsigned long endMs = millis();
+
+        task.runs++;
+        task.lastUs = elapsed;
+        task.totalUs += elapsed;
+        if (elapsed > task.maxUs) task.maxUs = elapsed;
+
+        // A job split into slices is judged once, when its last slice ends.
+        if (task.pending) continue;
+        if (endMs - task.due > task.deadline) task.overruns++;
+        if (task.period == 0) {
+            task.due = endMs;
+        } else {
+            task.due += task.period;
+            // Skip missed periods instead of running a burst to catch up.
+            if ((long)(endMs - task.due) >= 0) task.due = endMs + task.period - (endMs - task.due) % task.period;
+        }
+    }
+
+    passes++;
+    uint32_t passUs = micros() - passStart;
+    if (passUs > maxPassUs) maxPassUs = passUs;
+}
+
+void schedulerWriteDiag(Print &out) {
+    out.printf("{\"uptime\":%lu,\"passes\":%u,\"maxPassUs\":%u,\"tasks\":[", millis(), passes, maxPassUs);
+    for (uint8_t i = 0; i < taskCount; i++) {
+        const Task &task = tasks[i];
+        uint32_t avg = task.runs > 0 ? (uint32_t)(task.totalUs / task.runs) : 0;
+        out.printf("%s{\"name\":\"%s\",\"priority\":%u,\"period\":%u,\"deadline\":%u,\"runs\":%u,"
+                   "\"avgUs\":%u,\"maxUs\":%u,\"lastUs\":%u,\"overruns\":%u,\"pending\":%s}",
+                   i ? "," : "", task.name, task.priority, task.period, task.deadline, task.runs,
+                   avg, task.maxUs, task.lastUs, task.overruns, task.pending ? "true" : "false");
+    }
+    out.print("]}");
+}
@@ -0,0 +1,50 @@
+/**
+ * @file Scheduler.h
+ * @brief Cooperative scheduler for the main loop.
+ * @details Tasks are plain functions registered with a period, a priority
+ *          and a deadline. Every schedulerRun() call (one per loop pass)
+ *          runs each due task once, highest priority first. A task that
+ *          returns true has more work pending and runs again on the next
+ *          pass, so long jobs are split into short slices with every other
+ *          task getting its turn in between. Run time and deadline misses
+ *          are accounted per task.
+ */
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <Arduino.h>
+#include "AppConfig.h"
+
+enum TaskPriority : uint8_t { TASK_HIGH, TASK_NORMAL, TASK_LOW };
+
+/**
+ * @brief Task body.
+ * @param nowMs millis() at the start of the scheduler pass.
+ * @return true if the task has more work and wants the next pass too.
+ */
+typedef bool (*TaskFunction)(unsigned long nowMs);
+
+/**
+ * @brief Registers a task.
+ * @param name Static name shown in the diagnostics.
+ * @param fn Task body.
+ * @param periodMs Time between runs (0 runs on every pass).
+ * @param priority Order within a pass.
+ * @param deadlineMs A run that ends more than this after the task became
+ *        due counts as an overrun.
+ * @return false if the task table is full.
+ */
+bool taskAdd(const char *name, TaskFunction fn, uint32_t periodMs, TaskPriority priority, uint32_t deadlineMs);
+
+/**
+ * @brief Runs every due task once. Call from loop().
+ */
+void schedulerRun();
+
+/**
+ * @brief Writes per-task statistics as a JSON object.
+ */
+void schedulerWriteDiag(Print &out);
+
+#endif // SCHEDULER_H
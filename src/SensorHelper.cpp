@@ -0,0 +1,160 @@
+/**
+ * @file SensorHelper.cpp
+ * @brief Implementation of the asynchronous sensor pipeline.
+ */
+
+#include "SensorHelper.h"
+#include "FixedPoint.h"
+#include "Metrics.h"
+
+enum SensorState { SENSOR_IDLE, SENSOR_CONVERTING };
+
+static DallasTemperature *bus = nullptr;
+static SensorState state = SENSOR_IDLE;
+static uint8_t bits = 12;
+static uint32_t period = 1000;
+static uint16_t conversionMs = 750;
+static unsigned long lastStart = 0;
+static bool started = false;
+
+static uint8_t (*slotRoms)[8] = nullptr;
+static void (*onAssigned)(uint8_t, bool) = nullptr;
+static bool present[MAX_SENSORS];
+static bool replaced[MAX_SENSORS];
+static uint8_t count = 0;
+
+static bool isFree(const uint8_t *rom) {
+    for (uint8_t i = 0; i < 8; i++) {
+        if (rom[i] != 0) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Slot holding `address`, or -1.
+ */
+static int8_t findSlot(const DeviceAddress address) {
+    for (uint8_t s = 0; s < MAX_SENSORS; s++) {
+        if (memcmp(slotRoms[s], address, 8) == 0) return (int8_t)s;
+    }
+    return -1;
+}
+
+/**
+ * @brief Slot for a probe not seen before: the first free one, else the
+ *        first whose probe is missing (reused). -1 if every probe is here.
+ */
+static int8_t newSlot() {
+    for (uint8_t s = 0; s < MAX_SENSORS; s++) {
+        if (isFree(slotRoms[s])) return (int8_t)s;
+    }
+    for (uint8_t s = 0; s < MAX_SENSORS; s++) {
+        if (!present[s]) return (int8_t)s;
+    }
+    return -1;
+}
+
+/**
+ * @brief Enumerates the bus and maps every probe to its slot.
+ * @details Known probes are placed first, so a new probe found earlier on
+ *          the bus cannot take the slot of a known one that is present.
+ */
+static void discover() {
+    count = 0;
+    memset(present, 0, sizeof(present));
+    bus->begin();
+    uint8_t found = bus->getDeviceCount();
+    DeviceAddress address;
+    for (uint8_t pass = 0; pass < 2; pass++) {
+        for (uint8_t i = 0; i < found && count < MAX_SENSORS; i++) {
+            if (!bus->getAddress(address, i) || isFree(address)) continue;
+            int8_t s = findSlot(address);
+            if (pass == 0 ? s < 0 : s >= 0) continue;
+            if (s < 0) {
+                s = newSlot();
+                if (s < 0) break;
+                bool reused = !isFree(slotRoms[s]);
+                memcpy(slotRoms[s], address, 8);
+                if (reused) replaced[s] = true;
+                if (onAssigned != nullptr) onAssigned((uint8_t)s, reused);
+            }
+            present[s] = true;
+            bus->setResolution(address, bits);
+            count++;
+        }
+    }
+}
+
+void sensorBegin(DallasTemperature &sensors, uint8_t resolution, uint32_t periodMs,
+                 uint8_t (*roms)[8], void (*assigned)(uint8_t slot, bool reused)) {
+    bus = &sensors;
+    slotRoms = roms;
+    onAssigned = assigned;
+    bits = resolution;
+    period = periodMs;
+    discover();
+    bus->setWaitForConversion(false);
+    conversionMs = bus->millisToWaitForConversion(resolution);
+    state = SENSOR_IDLE;
+    started = false;
+}
+
+bool sensorPoll(unsigned long nowMs, int16_t *centi) {
+    if (bus == nullptr) return false;
+
+    switch (state) {
+    case SENSOR_IDLE:
+        if (started && nowMs - lastStart < period) return false;
+        lastStart = nowMs;
+        started = true;
+        // Nothing to convert: retry discovery once per period instead.
+        if (count == 0) {
+            discover();
+            bus->setWaitForConversion(false);
+            return false;
+        }
+        bus->requestTemperatures();
+        state = SENSOR_CONVERTING;
+        return false;
+
+    case SENSOR_CONVERTING: {
+        if (nowMs - lastStart < conversionMs) return false;
+        METRIC_SCOPE(METRIC_SENSOR_READ);
+        state = SENSOR_IDLE;
+        bool updated = false;
+        for (uint8_t i = 0; i < MAX_SENSORS; i++) {
+            if (!present[i]) continue;
+            // Raw 1/128 degree reading; a disconnected probe (-127 C) falls outside the range.
+            int16_t t = rawToCenti(bus->getTemp(slotRoms[i]));
+            if (t > -5000 && t < 10000) {
+                centi[i] = t;
+                updated = true;
+            }
+        }
+        return updated;
+    }
+    }
+    return false;
+}
+
+uint8_t sensorSlots() {
+    uint8_t n = 0;
+    for (uint8_t s = 0; slotRoms != nullptr && s < MAX_SENSORS; s++) {
+        if (!isFree(slotRoms[s])) n = s + 1;
+    }
+    return n;
+}
+
+bool sensorPresent(uint8_t slot) {
+    return slot < MAX_SENSORS && present[slot];
+}
+
+bool sensorReplaced(uint8_t slot) {
+    return slot < MAX_SENSORS && replaced[slot];
+}
+
+void sensorAddress(uint8_t slot, char *out) {
+    out[0] = '\0';
+    if (slot >= sensorSlots() || isFree(slotRoms[slot])) return;
+    for (uint8_t i = 0; i < 8; i++) sprintf(out + i * 2, "%02X", slotRoms[slot][i]);
+}
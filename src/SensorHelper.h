@@ -0,0 +1,75 @@
+/**
+ * @file SensorHelper.h
+ * @brief Non-blocking multi-sensor DS18B20 acquisition state machine.
+ * @details The ROM address of every sensor on the bus is discovered once at
+ *          start-up and cached. Each probe keeps a sensor slot (its limits
+ *          and log) by its address, so adding or removing a probe does not
+ *          shift the others to a different slot. Each sampling period one bus-wide conversion
+ *          is started without waiting for it; the results are collected by
+ *          address on a later loop pass once the conversion time for the
+ *          configured resolution has elapsed. The loop (and the web server)
+ *          keeps running in between.
+ */
+
+#ifndef SENSOR_HELPER_H
+#define SENSOR_HELPER_H
+
+#include <Arduino.h>
+#include <DallasTemperature.h>
+#include "AppConfig.h"
+
+/**
+ * @brief Discovers the sensors and configures the bus for asynchronous
+ *        conversions.
+ * @details A probe takes the slot that holds its address in `roms`. A new
+ *          probe takes the first slot without an address. Only when every
+ *          slot is assigned is the first one whose probe is missing reused;
+ *          the caller must then drop that slot's history and limits. Slots
+ *          are assigned in bus order, so a table without addresses (written
+ *          by earlier firmware) keeps the slots the probes had before.
+ * @param sensors Initialised DallasTemperature instance.
+ * @param resolution Conversion resolution in bits (9..12).
+ * @param periodMs Time between conversion starts in milliseconds.
+ * @param roms MAX_SENSORS ROM addresses, one per slot (all zero: free);
+ *        kept and updated when a new probe is assigned.
+ * @param assigned Called for every slot given to a new probe, after `roms`
+ *        was updated; `reused` is true if the slot belonged to another
+ *        (missing) probe.
+ */
+void sensorBegin(DallasTemperature &sensors, uint8_t resolution, uint32_t periodMs,
+                 uint8_t (*roms)[8], void (*assigned)(uint8_t slot, bool reused));
+
+/**
+ * @brief Advances the state machine. Call on every loop pass.
+ * @param nowMs Current millis().
+ * @param centi Array of MAX_SENSORS temperatures in centi-degrees, by
+ *              slot; entries of sensors that returned a valid reading are
+ *              updated.
+ * @return true if at least one entry of `centi` was updated.
+ */
+bool sensorPoll(unsigned long nowMs, int16_t *centi);
+
+/**
+ * @brief Number of slots up to the last one assigned to a probe, whether
+ *        that probe is on the bus or not.
+ */
+uint8_t sensorSlots();
+
+/**
+ * @brief Whether the probe of a slot was found on the bus.
+ */
+bool sensorPresent(uint8_t slot);
+
+/**
+ * @brief Whether the slot was reused for a new probe since boot.
+ */
+bool sensorReplaced(uint8_t slot);
+
+/**
+ * @brief Formats the ROM address assigned to a slot as 16 hex digits.
+ * @param slot Sensor slot.
+ * @param out Buffer of at least 17 bytes; empty if the slot is free.
+ */
+void sensorAddress(uint8_t slot, char *out);
+
+#endif // SENSOR_HELPER_H
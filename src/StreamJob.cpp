@@ -0,0 +1,99 @@
+/**
+ * @file StreamJob.cpp
+ * @brief Implementation of the sliced response jobs.
+ */
+
+#include "StreamJob.h"
+#include "ChunkedPrint.h"
+#include "Metrics.h"
+
+enum JobKind : uint8_t { JOB_FREE, JOB_HISTORY, JOB_EXPORT };
+
+struct Job {
+    JobKind kind;
+    uint32_t startUs;
+    union {
+        HistoryCursor history;
+        ExportCursor exported;
+    };
+    ClientChunkedPrint<> out;
+};
+
+static Job jobs[STREAM_MAX_JOBS];
+
+/**
+ * @brief Finds a free slot and sends the response head on `client`.
+ */
+static Job *startJob(WiFiClient &client, const char *contentType, const char *extraHeader) {
+    for (auto &job : jobs) {
+        if (job.kind != JOB_FREE) continue;
+        job.out.begin(client);
+        job.startUs = micros();
+        client.setNoDelay(true);
+        client.printf("HTTP/1.1 200 OK\r\n"
+                      "Content-Type: %s\r\n"
+                      "Transfer-Encoding: chunked\r\n"
+                      "Cache-Control: no-cache\r\n"
+                      "Connection: close\r\n"
+                      "%s\r\n",
+                      contentType, extraHeader);
+        return &job;
+    }
+    return nullptr;
+}
+
+bool streamHistory(WiFiClient client, const HistoryCursor &cur) {
+    Job *job = startJob(client, "application/json", "");
+    if (job == nullptr) return false;
+    job->history = cur;
+    job->kind = JOB_HISTORY;
+    return true;
+}
+
+bool streamExport(WiFiClient client, const ExportCursor &cur, const char *filename) {
+    char header[64];
+    snprintf(header, sizeof(header), "Content-Disposition: attachment; filename=\"%s\"\r\n", filename);
+    Job *job = startJob(client, cur.binary ? "application/octet-stream" : "text/csv", header);
+    if (job == nullptr) return false;
+    job->exported = cur;
+    job->kind = JOB_EXPORT;
+    return true;
+}
+
+bool streamRun(unsigned long nowMs) {
+    (void)nowMs;
+    bool active = false;
+    for (auto &job : jobs) {
+        if (job.kind == JOB_FREE) continue;
+        WiFiClient &client = job.out.client();
+        if (!client.connected()) {
+            if (job.kind == JOB_EXPORT) exportEnd(job.exported);
+            client.stop();
+            job.kind = JOB_FREE;
+            continue;
+        }
+        active = true;
+        // Wait for the peer instead of blocking in write() on a full window.
+        if (client.availableForWrite() < 1024) continue;
+
+        bool more = job.kind == JOB_HISTORY ? historyStep(job.history, job.out, STREAM_SLICE_BINS)
+                                            : exportStep(job.exported, job.out, STREAM_SLICE_RECORDS);
+        if (!more) {
+            job.out.end();
+#if METRICS_ENABLED
+            metricsRecord(METRIC_STREAM_JOB, micros() - job.startUs);
+#endif
+            client.stop();
+            job.kind = JOB_FREE;
+        }
+    }
+    return active;
+}
+
+uint8_t streamJobs() {
+    uint8_t n = 0;
+    for (auto &job : jobs) {
+        if (job.kind != JOB_FREE) n++;
+    }
+    return n;
+}
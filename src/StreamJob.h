@@ -0,0 +1,43 @@
+/**
+ * @file StreamJob.h
+ * @brief Long responses written in slices from the scheduler.
+ * @details A route handler hands its client connection and a prepared
+ *          cursor to a job slot and returns at once. streamRun() then
+ *          writes one slice per job on every scheduler pass, as chunked
+ *          transfer encoding, so history and export downloads never hold
+ *          the loop for more than one slice.
+ */
+
+#ifndef STREAM_JOB_H
+#define STREAM_JOB_H
+
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include "AppConfig.h"
+#include "LogHelper.h"
+
+/**
+ * @brief Takes over a client to send a history response.
+ * @return false if every job slot is busy; the caller must answer itself.
+ */
+bool streamHistory(WiFiClient client, const HistoryCursor &cur);
+
+/**
+ * @brief Takes over a client to send an export.
+ * @param filename Name suggested in Content-Disposition.
+ * @return false if every job slot is busy; the caller must answer itself.
+ */
+bool streamExport(WiFiClient client, const ExportCursor &cur, const char *filename);
+
+/**
+ * @brief Writes one slice of every active job (scheduler task body).
+ * @return true while any job is still active.
+ */
+bool streamRun(unsigned long nowMs);
+
+/**
+ * @brief Number of jobs in progress.
+ */
+uint8_t streamJobs();
+
+#endif // STREAM_JOB_H
@@ -0,0 +1,66 @@
+/**
+ * @file TimeIndex.cpp
+ * @brief Implementation of the sparse time index.
+ */
+
+#include "TimeIndex.h"
+
+bool TimeIndex::begin(const char *path, uint32_t bucketSeconds, uint32_t capacity) {
+    _bucketSeconds = bucketSeconds;
+    _lastStart = UINT32_MAX;
+    _stagedCount = 0;
+    if (!_ring.begin(path, sizeof(IndexEntry), capacity)) return false;
+
+    IndexEntry entry;
+    if (last(entry)) _lastStart = entry.start;
+    return true;
+}
+
+void TimeIndex::add(uint32_t timestamp, uint32_t seq) {
+    uint32_t start = timestamp - timestamp % _bucketSeconds;
+    if (start == _lastStart) return;
+
+    if (_stagedCount == LOG_INDEX_STAGED) flush();
+    _staged[_stagedCount++] = {start, seq};
+    _lastStart = start;
+}
+
+bool TimeIndex::flush() {
+    if (_stagedCount == 0) return true;
+    bool ok = _ring.append(_staged, _stagedCount);
+    _stagedCount = 0;
+    return ok;
+}
+
+bool TimeIndex::lookup(uint32_t timestamp, uint32_t &seq) {
+    // Staged entries are the newest
+    for (uint8_t i = _stagedCount; i > 0; i--) {
+        if (_staged[i - 1].start <= timestamp) {
+            seq = _staged[i - 1].seq;
+            return true;
+        }
+    }
+    // First entry that starts after `timestamp`; the one before it holds it.
+    uint32_t next = _ring.lowerBound(timestamp + 1);
+    if (next == 0) return false;
+
+    IndexEntry entry;
+    if (_ring.read(next - 1, &entry, 1) != 1) return false;
+    seq = entry.seq;
+    return true;
+}
+
+bool TimeIndex::last(IndexEntry &entry) {
+    if (_stagedCount > 0) {
+        entry = _staged[_stagedCount - 1];
+        return true;
+    }
+    if (_ring.count() == 0) return false;
+    return _ring.read(_ring.count() - 1, &entry, 1) == 1;
+}
+
+void TimeIndex::clear() {
+    _ring.clear();
+    _stagedCount = 0;
+    _lastStart = UINT32_MAX;
+}
@@ -0,0 +1,79 @@
+/**
+ * @file TimeIndex.h
+ * @brief Sparse time index over a record ring.
+ * @details Stores one entry per time bucket (e.g. one per hour) holding the
+ *          sequence number of the first record written in that bucket. A
+ *          sequence number counts every record ever appended to the ring, so
+ *          an entry stays valid while the ring wraps; it only goes stale once
+ *          the record it points to has been overwritten.
+ *
+ *          New entries are staged in RAM and written LOG_INDEX_STAGED at a
+ *          time. Entries lost with a reset only make lookups in those hours
+ *          scan from an older entry until the log adds them again from the
+ *          raw records (see loadIndex() in LogHelper.cpp).
+ */
+
+#ifndef TIME_INDEX_H
+#define TIME_INDEX_H
+
+#include <Arduino.h>
+#include "LogStore.h"
+#include "AppConfig.h"
+
+/**
+ * @brief One index entry.
+ */
+struct __attribute__((packed)) IndexEntry {
+    uint32_t start;  ///< Bucket start (aligned to the bucket width)
+    uint32_t seq;    ///< Sequence number of the first record in the bucket
+};
+
+class TimeIndex {
+public:
+    /**
+     * @brief Opens the index file.
+     * @param path Prefix of the index ring's segment files (see RingLog::begin()).
+     * @param bucketSeconds Time covered by one entry.
+     * @param capacity Number of entries kept.
+     */
+    bool begin(const char *path, uint32_t bucketSeconds, uint32_t capacity);
+
+    /**
+     * @brief Records that the record with sequence number `seq` was
+     *        written; stages an entry if it starts a new bucket.
+     */
+    void add(uint32_t timestamp, uint32_t seq);
+
+    /**
+     * @brief Finds the bucket containing `timestamp`.
+     * @param seq Receives the sequence number of the bucket's first record.
+     * @return false if `timestamp` precedes every entry or the index is empty.
+     */
+    bool lookup(uint32_t timestamp, uint32_t &seq);
+
+    /**
+     * @brief Reads the newest entry.
+     * @return false if the index is empty.
+     */
+    bool last(IndexEntry &entry);
+
+    /**
+     * @brief Writes the staged entries. Entries that fail to be written
+     *        are dropped.
+     */
+    bool flush();
+
+    /**
+     * @brief Drops every entry.
+     */
+    void clear();
+
+private:
+    RingLog _ring;
+    uint32_t _bucketSeconds = 3600;
+    uint32_t _lastStart = UINT32_MAX;
+    IndexEntry _staged[LOG_INDEX_STAGED];
+    uint8_t _stagedCount = 0;
+};
+
+#endif // TIME_INDEX_H
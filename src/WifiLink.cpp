@@ -0,0 +1,98 @@
+/**
+ * @file WifiLink.cpp
+ * @brief Implementation of the Wi-Fi state machine.
+ */
+
+#include "WifiLink.h"
+
+enum LinkState : uint8_t { LINK_CONNECTING, LINK_UP, LINK_BACKOFF };
+
+static const char *const STATE_NAMES[] = {"connecting", "up", "backoff"};
+
+static LinkState state = LINK_BACKOFF;
+static uint8_t bssid[6];
+static uint8_t channel = 0;
+static bool useHint = false;      // Current attempt targets the cached access point
+static unsigned long attemptStart;
+static unsigned long retryAt;
+static uint32_t backoff = WIFI_BACKOFF_MIN_MS;
+static uint32_t attempts = 0;
+static uint32_t drops = 0;
+
+static void startAttempt(unsigned long nowMs) {
+    attempts++;
+    WiFi.begin(WIFI_SSID, WIFI_PASS, useHint ? channel : 0, useHint ? bssid : nullptr);
+    state = LINK_CONNECTING;
+    attemptStart = nowMs;
+}
+
+void wifiBegin(const uint8_t *cachedBssid, uint8_t cachedChannel) {
+    // The SDK would otherwise write its own copy of the credentials to flash
+    // on every begin(), and reconnect on a schedule of its own.
+    WiFi.persistent(false);
+    WiFi.mode(WIFI_STA);
+    WiFi.setAutoReconnect(false);
+    WiFi.config(LOCAL_IP, GATEWAY, SUBNET, DNS_SERVER);
+
+    memcpy(bssid, cachedBssid, sizeof(bssid));
+    channel = cachedChannel;
+    useHint = channel != 0;
+    backoff = WIFI_BACKOFF_MIN_MS;
+    startAttempt(millis());
+}
+
+WifiEvent wifiPoll(unsigned long nowMs) {
+    wl_status_t status = WiFi.status();
+
+    switch (state) {
+    case LINK_CONNECTING: {
+        if (status == WL_CONNECTED) {
+            state = LINK_UP;
+            backoff = WIFI_BACKOFF_MIN_MS;
+            memcpy(bssid, WiFi.BSSID(), sizeof(bssid));
+            channel = WiFi.channel();
+            return WIFI_EVENT_UP;
+        }
+        uint32_t timeout = useHint ? WIFI_HINT_TIMEOUT_MS : WIFI_CONNECT_TIMEOUT_MS;
+        bool failed = status == WL_CONNECT_FAILED || status == WL_NO_SSID_AVAIL;
+        if (!failed && nowMs - attemptStart < timeout) return WIFI_EVENT_NONE;
+
+        WiFi.disconnect();
+        if (useHint) {
+            // The access point may have moved to another channel: scan now.
+            useHint = false;
+            startAttempt(nowMs);
+            return WIFI_EVENT_NONE;
+        }
+        state = LINK_BACKOFF;
+        retryAt = nowMs + backoff;
+        backoff = backoff * 2 < WIFI_BACKOFF_MAX_MS ? backoff * 2 : WIFI_BACKOFF_MAX_MS;
+        return WIFI_EVENT_NONE;
+    }
+
+    case LINK_BACKOFF:
+        if ((long)(nowMs - retryAt) < 0) return WIFI_EVENT_NONE;
+        useHint = channel != 0;
+        startAttempt(nowMs);
+        return WIFI_EVENT_NONE;
+
+    case LINK_UP:
+        if (status == WL_CONNECTED) return WIFI_EVENT_NONE;
+        drops++;
+        useHint = true;
+        startAttempt(nowMs);
+        return WIFI_EVENT_DOWN;
+    }
+    return WIFI_EVENT_NONE;
+}
+
+bool wifiConnected() {
+    return state == LINK_UP;
+}
+
+void wifiWriteDiag(Print &out) {
+    long retryIn = state == LINK_BACKOFF ? (long)(retryAt - millis()) : 0;
+    out.printf("{\"state\":\"%s\",\"attempts\":%u,\"drops\":%u,\"channel\":%u,\"hint\":%s,\"retryInMs\":%ld}",
+               STATE_NAMES[state], attempts, drops, channel, useHint ? "true" : "false",
+               retryIn > 0 ? retryIn : 0L);
+}
@@ -0,0 +1,46 @@
+/**
+ * @file WifiLink.h
+ * @brief Background Wi-Fi connection state machine.
+ * @details Nothing here blocks: wifiBegin() starts the first attempt and
+ *          wifiPoll(), called from a scheduler task, follows it up. An
+ *          attempt first goes straight to the cached BSSID and channel,
+ *          which skips the scan. If that fails, the next attempt scans. A
+ *          failed scan is retried after a delay that doubles up to
+ *          WIFI_BACKOFF_MAX_MS. A dropped link is reconnected at once, with
+ *          the cached access point.
+ */
+
+#ifndef WIFI_LINK_H
+#define WIFI_LINK_H
+
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include "AppConfig.h"
+
+enum WifiEvent : uint8_t { WIFI_EVENT_NONE, WIFI_EVENT_UP, WIFI_EVENT_DOWN };
+
+/**
+ * @brief Configures the station and starts the first connection attempt.
+ * @param bssid Cached access point (6 bytes).
+ * @param channel Its channel, or 0 if nothing is cached.
+ */
+void wifiBegin(const uint8_t *bssid, uint8_t channel);
+
+/**
+ * @brief Advances the state machine.
+ * @return WIFI_EVENT_UP when the link has just come up (WiFi.BSSID() and
+ *         WiFi.channel() then describe it), WIFI_EVENT_DOWN when it was lost.
+ */
+WifiEvent wifiPoll(unsigned long nowMs);
+
+/**
+ * @brief true while the link is up.
+ */
+bool wifiConnected();
+
+/**
+ * @brief Writes the link state as a JSON object.
+ */
+void wifiWriteDiag(Print &out);
+
+#endif // WIFI_LINK_H
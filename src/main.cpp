@@ -6,7 +6,6 @@
 
 #include <ESP8266WiFi.h>
 #include <ESP8266WebServer.h>
-#include <EEPROM.h>
 #include <LittleFS.h>
 #include <OneWire.h>
 #include <DallasTemperature.h>
@@ -15,8 +14,18 @@
 #include <RTClib.h>
 
 #include "AppConfig.h"
-#include "WebPages.h"
+#include "WebPagesGz.h"
 #include "LogHelper.h"
+#include "SensorHelper.h"
+#include "ChunkedPrint.h"
+#include "EventStream.h"
+#include "FixedPoint.h"
+#include "Scheduler.h"
+#include "StreamJob.h"
+#include "Metrics.h"
+#include "ConfigStore.h"
+#include "WifiLink.h"
+#include "BootTrace.h"
 
 // --- Global Objects ---
 OneWire oneWire(PIN_DS18B20);
@@ -27,26 +36,275 @@ RTC_DS3231 rtc;
 
 // --- Global Variables ---
 SystemConfig config;
-float currentTemp = 0.0;
-unsigned long lastTempRead = 0;
-unsigned long lastLogFile = 0;
+int16_t currentTemps[MAX_SENSORS] = {0};  // Centi-degrees
 unsigned long buzzerTimer = 0;
 bool buzzerState = false;
 bool showTempOnDisplay = true;
+bool haveSample = false;     // A conversion has completed since boot
+bool serverStarted = false;  // server.begin() waits for the first Wi-Fi link
+uint8_t reusedSlots = 0;     // Slots handed to a new probe whose old log is still to be dropped
+bool clockLost = false;      // The RTC lost power and was not set since; nothing is logged
+uint32_t clockRead = 0;      // Last RTC reading by logTime()...
+unsigned long clockReadMs = 0;  // ...and the millis() it was taken at
+const SensorLimits DEFAULT_LIMITS = {2500, 3000};  // 25.0 / 30.0 C
 
+/**
+ * @brief Loads the config from the journal, with defaults for anything
+ *        missing, and persists it if it had to be created or converted.
+ */
 void loadConfig() {
-  EEPROM.begin(512);
-  EEPROM.get(0, config);
-  if (isnan(config.greenLimit)) { 
-    config.greenLimit = 25.0; 
-    config.yellowLimit = 30.0;
-    config.webSoundEnabled = true;
+  config = SystemConfig();
+  config.schema = CONFIG_SCHEMA;
+  for (auto &l : config.limits) l = {INT16_MIN, INT16_MIN};
+  config.webSoundEnabled = true;
+  configBegin(config);
+  if (config.limits[0].green == INT16_MIN || config.limits[0].yellow <= config.limits[0].green) {
+    config.limits[0] = DEFAULT_LIMITS;
+  }
+  // Sensors without stored limits (e.g. after upgrading from one sensor) start with sensor 0's
+  for (uint8_t i = 1; i < MAX_SENSORS; i++) {
+    SensorLimits &l = config.limits[i];
+    if (l.green == INT16_MIN || l.yellow <= l.green) l = config.limits[0];
+  }
+  configCommit();
+}
+
+/**
+ * @brief A sensor slot was given to a new probe. A reused slot starts over
+ *        with default limits, and its log is dropped once the logs are open.
+ */
+void sensorAssigned(uint8_t slot, bool reused) {
+  if (reused) {
+    config.limits[slot] = slot == 0 ? DEFAULT_LIMITS : config.limits[0];
+    logSetLimits(slot, config.limits[slot]);
+    reusedSlots |= 1 << slot;
+  }
+  configChanged(millis());
+}
+
+/**
+ * @brief Drops the logs of reused slots (see sensorAssigned()).
+ */
+void clearReusedLogs() {
+  for (uint8_t i = 0; reusedSlots != 0 && i < MAX_SENSORS; i++) {
+    if (reusedSlots & (1 << i)) clearSensorLog(i);
   }
+  reusedSlots = 0;
 }
 
-void saveConfig() {
-  EEPROM.put(0, config);
-  EEPROM.commit();
+/**
+ * @brief Sensor index selected by the "s" request argument (default 0).
+ */
+uint8_t selectedSensor() {
+  int s = server.arg("s").toInt();
+  if (s < 0 || s >= MAX_SENSORS) s = 0;
+  return (uint8_t)s;
+}
+
+/**
+ * @brief Sends a precompressed page, or 304 if the browser already has it.
+ */
+void sendPage(const uint8_t *gz, size_t len, const char *etag) {
+  if (server.header("If-None-Match") == etag) {
+    server.send(304);
+    return;
+  }
+  server.sendHeader("ETag", etag);
+  server.sendHeader("Cache-Control", "no-cache");
+  server.sendHeader("Content-Encoding", "gzip");
+  server.send_P(200, "text/html", (PGM_P)gz, len);
+}
+
+/**
+ * @brief Formats the status JSON of one sensor.
+ * @param withSeconds Include seconds in "time"; the event stream leaves
+ *        them out so that its frame only changes once per minute.
+ * @return Length of the JSON text.
+ */
+int buildStatusJson(uint8_t s, char *buf, size_t size, bool withSeconds) {
+  DateTime now = rtc.now();
+  const LogMeta &meta = getLogMeta(s);
+  char addr[17];
+  sensorAddress(s, addr);
+  char clock[16];  // hh:mm:ss, with room for any int so the format cannot truncate
+  if (withSeconds) snprintf(clock, sizeof(clock), "%02d:%02d:%02d", now.hour(), now.minute(), now.second());
+  else snprintf(clock, sizeof(clock), "%02d:%02d", now.hour(), now.minute());
+  char temp[10], green[10], yellow[10];
+  formatCenti(temp, currentTemps[s], 1);
+  formatCenti(green, config.limits[s].green, 1);
+  formatCenti(yellow, config.limits[s].yellow, 1);
+
+  int len = snprintf(buf, size, "{\"sensor\":%u,\"sensors\":%u,\"addr\":\"%s\",\"replaced\":%s,\"temp\":%s,\"time\":\"%s\",\"date\":\"%04d/%02d/%02d\",\"green\":%s,\"yellow\":%s,\"webSound\":%s,\"clockLost\":%s,\"logCount\":%u,\"logSize\":%u,\"logBytes\":%u,\"logFirst\":%u,\"logLast\":%u",
+          s, sensorSlots(), addr, sensorReplaced(s) ? "true" : "false",
+          temp, clock, now.year(), now.month(), now.day(),
+          green, yellow, config.webSoundEnabled?"true":"false", clockLost ? "true" : "false",
+          meta.count, meta.bytes/1024, meta.bytes, meta.firstTime, meta.lastTime);
+  // snprintf() returns the untruncated length; never index past the buffer
+  if (len < 0) return 0;
+  if ((size_t)len >= size) return (int)size - 1;
+  if (meta.count > 0) {
+    char lo[10], hi[10];
+    formatCenti(lo, meta.minCenti);
+    formatCenti(hi, meta.maxCenti);
+    len += snprintf(buf + len, size - len, ",\"logMin\":%s,\"logMax\":%s}", lo, hi);
+  }
+  else len += snprintf(buf + len, size - len, ",\"logMin\":null,\"logMax\":null}");
+  return (size_t)len >= size ? (int)size - 1 : len;
+}
+
+int buildEventFrame(uint8_t s, char *buf, size_t size) {
+  return buildStatusJson(s, buf, size, false);
+}
+
+/**
+ * @brief Alarm level of one sensor: 0 normal, 1 warning, 2 critical.
+ */
+int alarmLevel(uint8_t i) {
+  if (currentTemps[i] > config.limits[i].yellow) return 2;
+  if (currentTemps[i] > config.limits[i].green) return 1;
+  return 0;
+}
+
+/**
+ * @brief Registers a route, wrapped in a latency probe named after its path.
+ */
+void route(const char *path, void (*handler)()) {
+#if METRICS_ENABLED
+  uint8_t id = metricsRegister(path);
+  server.on(path, [id, handler]() {
+    METRIC_SCOPE(id);
+    handler();
+  });
+#else
+  server.on(path, handler);
+#endif
+}
+
+// --- Scheduler Tasks ---
+
+/**
+ * @brief The RTC time to log samples at, or 0 while it cannot be trusted.
+ * @details Nothing is logged while the clock lost power and was not set
+ *          since, or reads earlier than LOG_CLOCK_MIN. A reading that
+ *          strays from the previous one plus the uptime between them (a
+ *          garbled I2C read, or the clock was set) is held back until the
+ *          next one agrees with it.
+ */
+uint32_t logTime() {
+  uint32_t now = rtc.now().unixtime();
+  unsigned long nowMs = millis();
+  int32_t stray = (int32_t)(now - clockRead - (nowMs - clockReadMs) / 1000);
+  bool agrees = clockRead != 0 && (uint32_t)(stray < 0 ? -stray : stray) <= LOG_CLOCK_SLACK;
+  clockRead = now;
+  clockReadMs = nowMs;
+  clockLost = rtc.lostPower();
+  return agrees && !clockLost && now >= LOG_CLOCK_MIN ? now : 0;
+}
+
+void logSample() {
+  uint32_t now = logTime();
+  if (now == 0) return;
+  for (uint8_t i = 0; i < MAX_SENSORS; i++) {
+    if (sensorPresent(i)) appendLog(i, now, currentTemps[i]);
+  }
+}
+
+bool taskHttp(unsigned long) {
+  if (serverStarted) server.handleClient();
+  return false;
+}
+
+// Collect a finished conversion without blocking the loop. The first one is
+// logged at once instead of at the next run of the log task.
+bool taskSensor(unsigned long nowMs) {
+  bool updated = sensorPoll(nowMs, currentTemps);
+  clearReusedLogs();
+  if (updated && !haveSample) {
+    haveSample = true;
+    logSample();
+    bootMilestone("firstSample");
+  }
+  return false;
+}
+
+// Background Wi-Fi; the web server starts with the first link
+bool taskWifi(unsigned long nowMs) {
+  if (wifiPoll(nowMs) != WIFI_EVENT_UP) return false;
+  bootMilestone("wifi");
+  if (!serverStarted) {
+    server.begin();
+    serverStarted = true;
+    bootMilestone("server");
+  }
+  // Remember the access point so the next connect can skip the scan
+  if (config.wifiChannel != WiFi.channel() || memcmp(config.wifiBssid, WiFi.BSSID(), sizeof(config.wifiBssid)) != 0) {
+    memcpy(config.wifiBssid, WiFi.BSSID(), sizeof(config.wifiBssid));
+    config.wifiChannel = WiFi.channel();
+    configChanged(nowMs);
+  }
+  return false;
+}
+
+bool taskDisplay(unsigned long) {
+  if(showTempOnDisplay) {
+    display.showNumberDecEx(currentTemps[0], 0b01000000, true);
+  } else {
+    DateTime now = rtc.now();
+    display.showNumberDecEx((now.hour() * 100) + now.minute(), 0b01000000, true);
+  }
+  return false;
+}
+
+// Push changed status frames to /events subscribers
+bool taskEvents(unsigned long nowMs) {
+  eventsPoll(nowMs, buildEventFrame);
+  return false;
+}
+
+// Status LEDs (worst sensor wins) and buzzer
+bool taskAlarm(unsigned long nowMs) {
+  int level = 0;
+  for (uint8_t i = 0; i < MAX_SENSORS; i++) {
+    if (!sensorPresent(i)) continue;
+    int l = alarmLevel(i);
+    if (l > level) level = l;
+  }
+  digitalWrite(PIN_LED_GREEN, level == 0);
+  digitalWrite(PIN_LED_YELLOW, level == 1);
+  digitalWrite(PIN_LED_RED, level == 2);
+
+  bool touchActive = (digitalRead(PIN_TOUCH) == HIGH);
+  bool shouldBeep = (level == 2) && touchActive && config.webSoundEnabled;
+
+  if(shouldBeep) {
+    if(nowMs - buzzerTimer >= 200) {
+      buzzerTimer = nowMs;
+      buzzerState = !buzzerState;
+      if(buzzerState) {
+        analogWrite(PIN_BUZZER, 128);
+        tone(PIN_BUZZER, 1000, 100);
+      } else {
+        analogWrite(PIN_BUZZER, 128);
+        tone(PIN_BUZZER, 1500, 100);
+      }
+    }
+  } else {
+    noTone(PIN_BUZZER);
+    analogWrite(PIN_BUZZER, 0);
+    digitalWrite(PIN_BUZZER, LOW);
+  }
+  return false;
+}
+
+bool taskLog(unsigned long) {
+  // Nothing to log before the first conversion
+  if (haveSample) logSample();
+  return false;
+}
+
+// Seal finished days into the compressed archive, one slice per pass
+bool taskArchive(unsigned long) {
+  return logArchive();
 }
 
 void setup() {
@@ -56,74 +314,92 @@ void setup() {
   pinMode(PIN_LED_RED, OUTPUT);
   pinMode(PIN_BUZZER, OUTPUT);
   pinMode(PIN_TOUCH, INPUT);
+  bootPhase("pins");
 
   // Peripherals Init
   Wire.begin(SDA_PIN, SCL_PIN);
   rtc.begin();
+  logTime();  // The reading the first sample's must agree with
+  bootPhase("rtc");
   loadConfig();
+  for (uint8_t i = 0; i < MAX_SENSORS; i++) logSetLimits(i, config.limits[i]);
+  bootPhase("config");
   LittleFS.begin();
-  sensors.begin();
+  bootPhase("fs");
+  sensorBegin(sensors, SENSOR_RESOLUTION, SENSOR_PERIOD_MS, config.sensorRom, sensorAssigned);
+  bootPhase("sensors");
+  logBegin(sensorSlots());
+  clearReusedLogs();
+  bootPhase("log");
   display.setBrightness(0x0f);
-  
-  // WiFi Setup
-  if (!WiFi.config(LOCAL_IP, GATEWAY, SUBNET, DNS_SERVER)) {
-    // Fallback or error handling if needed
-  }
-  WiFi.begin(WIFI_SSID, WIFI_PASS);
-  while (WiFi.status() != WL_CONNECTED) {
-    delay(500);
-  }
+  bootPhase("display");
+
+  // Wi-Fi connects in the background (taskWifi); sensing, alarms and
+  // logging do not wait for it.
+  wifiBegin(config.wifiBssid, config.wifiChannel);
+  bootPhase("wifi");
 
   // --- Web Server Routes ---
-  server.on("/", [](){ server.send_P(200, "text/html", INDEX_HTML); });
-  server.on("/limits", [](){ server.send_P(200, "text/html", LIMITS_HTML); });
-  server.on("/set_time", [](){ server.send_P(200, "text/html", SET_TIME_HTML); });
-  server.on("/history", [](){ server.send_P(200, "text/html", HISTORY_HTML); });
+  route("/", [](){ sendPage(INDEX_HTML_GZ, INDEX_HTML_GZ_LEN, INDEX_HTML_ETAG); });
+  route("/limits", [](){ sendPage(LIMITS_HTML_GZ, LIMITS_HTML_GZ_LEN, LIMITS_HTML_ETAG); });
+  route("/set_time", [](){ sendPage(SET_TIME_HTML_GZ, SET_TIME_HTML_GZ_LEN, SET_TIME_HTML_ETAG); });
+  route("/history", [](){ sendPage(HISTORY_HTML_GZ, HISTORY_HTML_GZ_LEN, HISTORY_HTML_ETAG); });
 
-  server.on("/status", [](){
-    DateTime now = rtc.now();
-    int lines, sz;
-    getLogStats(lines, sz);
-    
+  route("/status", [](){
     char buf[512];
-    sprintf(buf, "{\"temp\":%.1f,\"time\":\"%02d:%02d:%02d\",\"date\":\"%04d/%02d/%02d\",\"green\":%.1f,\"yellow\":%.1f,\"webSound\":%s,\"logCount\":%d,\"logSize\":%d}",
-            currentTemp, now.hour(), now.minute(), now.second(), now.year(), now.month(), now.day(),
-            config.greenLimit, config.yellowLimit, config.webSoundEnabled?"true":"false", lines, sz/1024);
+    buildStatusJson(selectedSensor(), buf, sizeof(buf), true);
     server.send(200, "application/json", buf);
   });
 
-  server.on("/get_limits", [](){
-    char buf[60];
-    sprintf(buf, "{\"green\":%.1f,\"yellow\":%.1f}", config.greenLimit, config.yellowLimit);
+  route("/events", [](){
+    if (!eventsSubscribe(server.client(), selectedSensor())) {
+      server.send(503, "text/plain", "Too many subscribers");
+    }
+  });
+
+  route("/get_limits", [](){
+    uint8_t s = selectedSensor();
+    char buf[60], green[10], yellow[10];
+    formatCenti(green, config.limits[s].green, 1);
+    formatCenti(yellow, config.limits[s].yellow, 1);
+    sprintf(buf, "{\"green\":%s,\"yellow\":%s}", green, yellow);
     server.send(200, "application/json", buf);
   });
 
-  server.on("/save_limits", [](){
+  route("/save_limits", [](){
     if(server.hasArg("green") && server.hasArg("yellow")){
-      config.greenLimit = server.arg("green").toFloat();
-      config.yellowLimit = server.arg("yellow").toFloat();
-      saveConfig();
+      uint8_t s = selectedSensor();
+      int16_t green = parseCenti(server.arg("green").c_str());
+      int16_t yellow = parseCenti(server.arg("yellow").c_str());
+      if (green == INT16_MIN || yellow == INT16_MIN) {
+        server.send(400, "text/plain", "Bad limits");
+        return;
+      }
+      config.limits[s].green = green;
+      config.limits[s].yellow = yellow;
+      configChanged(millis());
+      logSetLimits(s, config.limits[s]);
     }
     server.send(200, "text/plain", "OK");
   });
 
-  server.on("/toggle_sound", [](){
+  route("/toggle_sound", [](){
     config.webSoundEnabled = !config.webSoundEnabled;
-    saveConfig();
+    configChanged(millis());
     server.send(200, "text/plain", "OK");
   });
 
-  server.on("/toggle_disp", [](){
+  route("/toggle_disp", [](){
     showTempOnDisplay = !showTempOnDisplay;
     server.send(200, "text/plain", "OK");
   });
 
-  server.on("/clear_log", [](){
+  route("/clear_log", [](){
     clearLogFile();
     server.send(200, "text/plain", "OK");
   });
 
-  server.on("/save_time", [](){
+  route("/save_time", [](){
     if(server.hasArg("dt")){
       String dt = server.arg("dt");
       int y = dt.substring(0,4).toInt();
@@ -132,69 +408,86 @@ void setup() {
       int hr = dt.substring(11,13).toInt();
       int mn = dt.substring(14,16).toInt();
       rtc.adjust(DateTime(y, m, d, hr, mn, 0));
+      logTime();  // The new time is the one to agree with
     }
     server.send(200, "text/html", "<html><body style='font-family:tahoma;text-align:center;padding:50px'><h2>OK</h2><br><a href='/'>Back</a></body></html>");
   });
 
-  server.on("/get_hist", [](){
-      int mode = server.arg("m").toInt();
-      long now = rtc.now().unixtime();
-      String json = getHistoryJson(mode, now);
-      server.send(200, "application/json", json);
+  route("/get_hist", [](){
+      HistoryCursor cur;
+      historyBegin(cur, selectedSensor(), server.arg("m").toInt(), rtc.now().unixtime(), server.arg("stats") == "1");
+      if (streamHistory(server.client(), cur)) return;
+      // Every job slot busy: answer inline
+      ChunkedPrint<> out(server, 200, "application/json");
+      while (historyStep(cur, out, STREAM_SLICE_BINS)) yield();
   });
 
-  server.begin();
-}
+  route("/chart.svg", [](){
+      server.sendHeader("Cache-Control", "no-cache");
+      ChunkedPrint<> out(server, 200, "image/svg+xml");
+      writeHistorySvg(selectedSensor(), server.arg("m").toInt(), rtc.now().unixtime(), out);
+  });
 
-void loop() {
-  server.handleClient();
-  unsigned long nowMs = millis();
+  route("/export", [](){
+      uint32_t from = server.hasArg("from") ? (uint32_t)server.arg("from").toInt() : 0;
+      uint32_t to = server.hasArg("to") ? (uint32_t)server.arg("to").toInt() : rtc.now().unixtime();
+      long step = server.arg("step").toInt();
+      bool binary = server.arg("format") == "bin";
+      if (from > to || step < 0) {
+        server.send(400, "text/plain", "Bad range");
+        return;
+      }
 
-  // Read Sensors & Update Display
-  if (nowMs - lastTempRead >= 1000) {
-    lastTempRead = nowMs;
-    sensors.requestTemperatures();
-    float t = sensors.getTempCByIndex(0);
-    if(t > -50 && t < 100) currentTemp = t;
-    
-    if(showTempOnDisplay) {
-      display.showNumberDecEx((int)(currentTemp * 100), 0b01000000, true);
-    } else {
-      DateTime now = rtc.now();
-      display.showNumberDecEx((now.hour() * 100) + now.minute(), 0b01000000, true);
-    }
+      uint8_t s = selectedSensor();
+      ExportCursor cur;
+      exportBegin(cur, s, from, to, (uint32_t)step, binary);
+      char filename[16];
+      snprintf(filename, sizeof(filename), "sensor%u.%s", s, binary ? "bin" : "csv");
+      if (streamExport(server.client(), cur, filename)) return;
 
-    // Update Status LEDs
-    digitalWrite(PIN_LED_GREEN, currentTemp <= config.greenLimit);
-    digitalWrite(PIN_LED_YELLOW, currentTemp > config.greenLimit && currentTemp <= config.yellowLimit);
-    digitalWrite(PIN_LED_RED, currentTemp > config.yellowLimit);
-    
-    // Handle Buzzer Logic
-    bool touchActive = (digitalRead(PIN_TOUCH) == HIGH);
-    bool shouldBeep = (currentTemp > config.yellowLimit) && touchActive && config.webSoundEnabled;
-    
-    if(shouldBeep) {
-      if(nowMs - buzzerTimer >= 200) {
-        buzzerTimer = nowMs;
-        buzzerState = !buzzerState;
-        if(buzzerState) {
-          analogWrite(PIN_BUZZER, 128);
-          tone(PIN_BUZZER, 1000, 100);
-        } else {
-          analogWrite(PIN_BUZZER, 128);
-          tone(PIN_BUZZER, 1500, 100);
-        }
-      }
-    } else {
-      noTone(PIN_BUZZER);
-      analogWrite(PIN_BUZZER, 0);
-      digitalWrite(PIN_BUZZER, LOW);
-    }
-  }
+      char disposition[48];
+      snprintf(disposition, sizeof(disposition), "attachment; filename=\"%s\"", filename);
+      server.sendHeader("Content-Disposition", disposition);
+      ChunkedPrint<1024> out(server, 200, binary ? "application/octet-stream" : "text/csv");
+      while (exportStep(cur, out, STREAM_SLICE_RECORDS)) yield();
+  });
 
-  // Logger Logic
-  if (nowMs - lastLogFile >= 60000) {
-    lastLogFile = nowMs;
-    appendLog(rtc.now().unixtime(), currentTemp);
-  }
-}
\ No newline at end of file
+  route("/diag", [](){
+      ChunkedPrint<> out(server, 200, "application/json");
+      out.print("{\"boot\":");
+      bootWriteDiag(out);
+      out.print(",\"wifi\":");
+      wifiWriteDiag(out);
+      out.print(",\"scheduler\":");
+      schedulerWriteDiag(out);
+      out.print("}");
+  });
+
+#if METRICS_ENABLED
+  route("/metrics", [](){
+      ChunkedPrint<> out(server, 200, "text/plain; version=0.0.4");
+      metricsWrite(out);
+  });
+#endif
+
+  const char *headerKeys[] = {"If-None-Match"};
+  server.collectHeaders(headerKeys, 1);
+  bootPhase("routes");
+
+  // --- Scheduler Tasks (name, body, period ms, priority, deadline ms) ---
+  taskAdd("http", taskHttp, 0, TASK_HIGH, 50);
+  taskAdd("sensor", taskSensor, 0, TASK_HIGH, 50);
+  taskAdd("alarm", taskAlarm, 200, TASK_HIGH, 50);
+  taskAdd("display", taskDisplay, 1000, TASK_NORMAL, 100);
+  taskAdd("events", taskEvents, 1000, TASK_NORMAL, 250);
+  taskAdd("wifi", taskWifi, 100, TASK_NORMAL, 50);
+  taskAdd("log", taskLog, 60000, TASK_NORMAL, 1000);
+  taskAdd("stream", streamRun, 0, TASK_LOW, 10000);
+  taskAdd("config", configTask, 1000, TASK_LOW, 200);
+  taskAdd("archive", taskArchive, 60000, TASK_LOW, 500);
+  bootPhase("tasks");
+}
+
+void loop() {
+  schedulerRun();
+}
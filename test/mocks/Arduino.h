@@ -0,0 +1,193 @@
+/**
+ * @file Arduino.h
+ * @brief Host stand-in for the parts of the ESP8266 Arduino core used by
+ *        the firmware (native environment only).
+ */
+
+#ifndef MOCK_ARDUINO_H
+#define MOCK_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <array>
+#include <chrono>
+#include <map>
+#include <string>
+#include <thread>
+
+#define PROGMEM
+#define PGM_P const char *
+#define PSTR(s) (s)
+#define F(s) (s)
+#define pgm_read_byte(p) (*(const uint8_t *)(p))
+#define memcpy_P memcpy
+#define strlen_P strlen
+#define strcpy_P strcpy
+#define snprintf_P snprintf
+
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x00
+#define OUTPUT 0x01
+
+enum { D0 = 16, D1 = 5, D2 = 4, D3 = 0, D4 = 2, D5 = 14, D6 = 12, D7 = 13, D8 = 15 };
+
+enum SeekMode { SeekSet = 0, SeekCur = 1, SeekEnd = 2 };
+
+namespace mock {
+inline std::chrono::steady_clock::time_point bootTime() {
+    static const auto t = std::chrono::steady_clock::now();
+    return t;
+}
+inline int pinLevels[32];
+/// Flash sectors touched through EspClass, erased (0xFF) on first use
+inline std::map<uint32_t, std::array<uint8_t, 4096>> flash;
+inline unsigned long flashErases = 0;
+inline unsigned long flashWrites = 0;
+/// Added to millis() and micros(), so a test can step past a retry delay
+inline unsigned long clockShiftMs = 0;
+}
+
+#define SPI_FLASH_SEC_SIZE 4096
+
+/// Linker symbol that marks the EEPROM sector (only its address is used)
+extern "C" {
+inline uint32_t _EEPROM_start;
+}
+
+inline unsigned long millis() {
+    using namespace std::chrono;
+    return (unsigned long)duration_cast<milliseconds>(steady_clock::now() - mock::bootTime()).count() + mock::clockShiftMs;
+}
+
+inline unsigned long micros() {
+    using namespace std::chrono;
+    return (unsigned long)duration_cast<microseconds>(steady_clock::now() - mock::bootTime()).count() + mock::clockShiftMs * 1000;
+}
+
+inline void delay(unsigned long ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+inline void yield() {}
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t pin, int value) { mock::pinLevels[pin & 31] = value; }
+inline int digitalRead(uint8_t pin) { return mock::pinLevels[pin & 31]; }
+inline void analogWrite(uint8_t pin, int value) { mock::pinLevels[pin & 31] = value; }
+inline void tone(uint8_t, unsigned int, unsigned long = 0) {}
+inline void noTone(uint8_t) {}
+
+/**
+ * @brief Subset of EspClass: user RTC memory (512 bytes that survive a
+ *        reset), raw flash access and heap statistics.
+ * @details Flash writes behave like NOR flash: they can only clear bits,
+ *          so writing over data that was not erased corrupts it.
+ */
+class EspClass {
+public:
+    bool rtcUserMemoryRead(uint32_t offset, uint32_t *data, size_t size) {
+        if (offset * 4 + size > sizeof(_rtc)) return false;
+        memcpy(data, _rtc + offset * 4, size);
+        return true;
+    }
+    bool rtcUserMemoryWrite(uint32_t offset, uint32_t *data, size_t size) {
+        if (offset * 4 + size > sizeof(_rtc)) return false;
+        memcpy(_rtc + offset * 4, data, size);
+        return true;
+    }
+    bool flashEraseSector(uint32_t sector) {
+        mock::flash[sector].fill(0xFF);
+        mock::flashErases++;
+        return true;
+    }
+    bool flashWrite(uint32_t address, const uint32_t *data, size_t size) {
+        if ((address | size) & 3) return false;
+        auto &sector = sectorOf(address);
+        const uint8_t *src = (const uint8_t *)data;
+        for (size_t i = 0; i < size; i++) sector[(address + i) % SPI_FLASH_SEC_SIZE] &= src[i];
+        mock::flashWrites++;
+        return true;
+    }
+    bool flashRead(uint32_t address, uint32_t *data, size_t size) {
+        if ((address | size) & 3) return false;
+        auto &sector = sectorOf(address);
+        memcpy(data, sector.data() + address % SPI_FLASH_SEC_SIZE, size);
+        return true;
+    }
+    uint32_t getFreeHeap() { return 40000; }
+    uint32_t getMaxFreeBlockSize() { return 30000; }
+    uint8_t getHeapFragmentation() { return 25; }
+    void restart() {}
+
+private:
+    static std::array<uint8_t, SPI_FLASH_SEC_SIZE> &sectorOf(uint32_t address) {
+        auto it = mock::flash.find(address / SPI_FLASH_SEC_SIZE);
+        if (it == mock::flash.end()) {
+            it = mock::flash.emplace(address / SPI_FLASH_SEC_SIZE, std::array<uint8_t, SPI_FLASH_SEC_SIZE>()).first;
+            it->second.fill(0xFF);
+        }
+        return it->second;
+    }
+
+    uint8_t _rtc[512] = {0};
+};
+
+inline EspClass ESP;
+
+/**
+ * @brief Minimal Arduino String on top of std::string.
+ */
+class String : public std::string {
+public:
+    String() {}
+    String(const char *s) : std::string(s ? s : "") {}
+    String(const std::string &s) : std::string(s) {}
+    String(int v) : std::string(std::to_string(v)) {}
+    String(unsigned v) : std::string(std::to_string(v)) {}
+    String(long v) : std::string(std::to_string(v)) {}
+
+    long toInt() const { return atol(c_str()); }
+    float toFloat() const { return (float)atof(c_str()); }
+    String substring(size_t from, size_t to = npos) const {
+        if (from >= size()) return String();
+        return String(substr(from, to == npos ? npos : to - from));
+    }
+    int indexOf(char c) const {
+        size_t p = find(c);
+        return p == npos ? -1 : (int)p;
+    }
+};
+
+/**
+ * @brief Arduino Print base class.
+ */
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *data, size_t size) {
+        for (size_t i = 0; i < size; i++) write(data[i]);
+        return size;
+    }
+    virtual void flush() {}
+
+    size_t write(const char *s) { return write((const uint8_t *)s, strlen(s)); }
+    size_t print(const char *s) { return write(s); }
+    size_t printf(const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+};
+
+#include <stdarg.h>
+inline size_t Print::printf(const char *fmt, ...) {
+    char buf[256];
+    va_list args;
+    va_start(args, fmt);
+    int len = vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+    if (len < 0) return 0;
+    if ((size_t)len >= sizeof(buf)) len = sizeof(buf) - 1;
+    return write((const uint8_t *)buf, len);
+}
+
+#endif // MOCK_ARDUINO_H
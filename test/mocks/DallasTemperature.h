@@ -0,0 +1,70 @@
+/**
+ * @file DallasTemperature.h
+ * @brief Host stand-in for DallasTemperature with simulated probes.
+ * @details The test sets mock::sensorCount and mock::sensorTemps; the probe
+ *          at bus position i has the ROM address 28 00 .. 00 <sensorIds[i]>
+ *          and reads sensorTemps[sensorIds[i]].
+ */
+
+#ifndef MOCK_DALLAS_TEMPERATURE_H
+#define MOCK_DALLAS_TEMPERATURE_H
+
+#include "Arduino.h"
+#include "OneWire.h"
+
+typedef uint8_t DeviceAddress[8];
+
+#define DEVICE_DISCONNECTED_C -127
+
+namespace mock {
+inline uint8_t sensorCount = 1;
+inline uint8_t sensorIds[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+inline float sensorTemps[8] = {24.5f, 24.5f, 24.5f, 24.5f, 24.5f, 24.5f, 24.5f, 24.5f};
+inline unsigned long conversionsStarted = 0;
+}
+
+class DallasTemperature {
+public:
+    explicit DallasTemperature(OneWire *) {}
+
+    void begin() {}
+    uint8_t getDeviceCount() { return mock::sensorCount; }
+    bool getAddress(uint8_t *address, uint8_t index) {
+        if (index >= mock::sensorCount) return false;
+        memset(address, 0, 8);
+        address[0] = 0x28;
+        address[7] = mock::sensorIds[index];
+        return true;
+    }
+    bool setResolution(const uint8_t *, uint8_t bits, bool = false) {
+        _bits = bits;
+        return true;
+    }
+    void setResolution(uint8_t bits) { _bits = bits; }
+    void setWaitForConversion(bool wait) { _wait = wait; }
+    static uint16_t millisToWaitForConversion(uint8_t bits) { return 750 / (1 << (12 - bits)); }
+
+    void requestTemperatures() {
+        mock::conversionsStarted++;
+        if (_wait) delay(millisToWaitForConversion(_bits));
+    }
+    float getTempC(const uint8_t *address) {
+        for (uint8_t i = 0; i < mock::sensorCount; i++) {
+            if (mock::sensorIds[i] == address[7]) return mock::sensorTemps[address[7] & 7];
+        }
+        return DEVICE_DISCONNECTED_C;
+    }
+    int16_t getTemp(const uint8_t *address) {
+        float t = getTempC(address);
+        return (int16_t)lroundf(t * 128.0f);
+    }
+    float getTempCByIndex(uint8_t index) {
+        return index < mock::sensorCount ? mock::sensorTemps[mock::sensorIds[index] & 7] : DEVICE_DISCONNECTED_C;
+    }
+
+private:
+    uint8_t _bits = 12;
+    bool _wait = true;
+};
+
+#endif // MOCK_DALLAS_TEMPERATURE_H
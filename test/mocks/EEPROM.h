@@ -0,0 +1,44 @@
+/**
+ * @file EEPROM.h
+ * @brief Host stand-in for the ESP8266 flash-emulated EEPROM.
+ */
+
+#ifndef MOCK_EEPROM_H
+#define MOCK_EEPROM_H
+
+#include "Arduino.h"
+
+namespace mock {
+inline unsigned long eepromCommits = 0;
+}
+
+class EEPROMClass {
+public:
+    void begin(size_t size) { _size = size < sizeof(_data) ? size : sizeof(_data); }
+    uint8_t read(int address) const { return _data[address]; }
+    void write(int address, uint8_t value) { _data[address] = value; }
+    template <typename T> T &get(int address, T &value) {
+        memcpy(&value, _data + address, sizeof(T));
+        return value;
+    }
+    template <typename T> const T &put(int address, const T &value) {
+        memcpy(_data + address, &value, sizeof(T));
+        return value;
+    }
+    bool commit() {
+        mock::eepromCommits++;
+        return true;
+    }
+    uint8_t *getDataPtr() { return _data; }
+    size_t length() const { return _size; }
+
+    EEPROMClass() { memset(_data, 0xFF, sizeof(_data)); }
+
+private:
+    uint8_t _data[4096];
+    size_t _size = 0;
+};
+
+inline EEPROMClass EEPROM;
+
+#endif // MOCK_EEPROM_H
@@ -0,0 +1,109 @@
+/**
+ * @file ESP8266WebServer.h
+ * @brief Host stand-in for ESP8266WebServer.
+ * @details Routes are registered as on the device; a test drives them with
+ *          request() and inspects the captured response.
+ */
+
+#ifndef MOCK_ESP8266_WEB_SERVER_H
+#define MOCK_ESP8266_WEB_SERVER_H
+
+#include "Arduino.h"
+#include "ESP8266WiFi.h"
+#include <functional>
+#include <map>
+
+#define CONTENT_LENGTH_UNKNOWN ((size_t)-1)
+
+class ESP8266WebServer {
+public:
+    typedef std::function<void(void)> THandlerFunction;
+
+    /**
+     * @brief Everything the last handler sent.
+     */
+    struct Response {
+        int code = 0;
+        std::string contentType;
+        std::string body;
+        std::map<std::string, std::string> headers;
+        size_t chunks = 0;
+    };
+
+    explicit ESP8266WebServer(int) {}
+
+    void on(const char *uri, THandlerFunction handler) { _routes[uri] = handler; }
+    void begin() {}
+    void handleClient() {}
+
+    bool hasArg(const char *name) const { return _args.count(name) > 0; }
+    String arg(const char *name) const {
+        auto it = _args.find(name);
+        return it == _args.end() ? String() : String(it->second);
+    }
+
+    WiFiClient client() { return _client; }
+
+    void collectHeaders(const char **, size_t) {}
+    bool hasHeader(const char *name) const { return _requestHeaders.count(name) > 0; }
+    String header(const char *name) const {
+        auto it = _requestHeaders.find(name);
+        return it == _requestHeaders.end() ? String() : String(it->second);
+    }
+
+    void setContentLength(size_t length) { _contentLength = length; }
+    void sendHeader(const String &name, const String &value, bool = false) { _response.headers[name] = value; }
+
+    void send(int code, const char *contentType = "", const String &content = String()) {
+        _response.code = code;
+        _response.contentType = contentType;
+        _response.body += content;
+    }
+    void send(int code, const char *contentType, const char *content) { send(code, contentType, String(content)); }
+    void send(int code, const char *contentType, const uint8_t *content, size_t length) {
+        send(code, contentType, String(std::string((const char *)content, length)));
+    }
+    void send_P(int code, PGM_P contentType, PGM_P content) { send(code, contentType, content); }
+    void send_P(int code, PGM_P contentType, PGM_P content, size_t length) {
+        send(code, contentType, (const uint8_t *)content, length);
+    }
+
+    void sendContent(const char *content, size_t length) {
+        _response.body.append(content, length);
+        if (length > 0) _response.chunks++;
+    }
+    void sendContent(const char *content) { sendContent(content, strlen(content)); }
+    void sendContent(const String &content) { sendContent(content.c_str(), content.size()); }
+
+    /**
+     * @brief Runs the handler registered for `uri` with the given arguments.
+     * @return The captured response (code 404 if no route matches).
+     */
+    const Response &request(const char *uri, const std::map<std::string, std::string> &args = {},
+                            const std::map<std::string, std::string> &headers = {}) {
+        _response = Response();
+        _client = WiFiClient();
+        _contentLength = 0;
+        _args = args;
+        _requestHeaders = headers;
+        auto it = _routes.find(uri);
+        if (it == _routes.end()) _response.code = 404;
+        else it->second();
+        return _response;
+    }
+
+    /**
+     * @brief Connection of the last request, for handlers that keep it open.
+     */
+    WiFiClient &lastClient() { return _client; }
+
+private:
+    std::map<std::string, THandlerFunction> _routes;
+    std::map<std::string, std::string> _args;
+    std::map<std::string, std::string> _requestHeaders;
+    Response _response;
+    WiFiClient _client;
+    size_t _contentLength = 0;
+};
+
+#endif // MOCK_ESP8266_WEB_SERVER_H
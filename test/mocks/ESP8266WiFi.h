@@ -0,0 +1,87 @@
+/**
+ * @file ESP8266WiFi.h
+ * @brief Host stand-in for the ESP8266 WiFi stack.
+ */
+
+#ifndef MOCK_ESP8266_WIFI_H
+#define MOCK_ESP8266_WIFI_H
+
+#include "Arduino.h"
+#include <memory>
+
+class IPAddress {
+public:
+    IPAddress() : _b{0, 0, 0, 0} {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : _b{a, b, c, d} {}
+    uint8_t operator[](int i) const { return _b[i]; }
+
+private:
+    uint8_t _b[4];
+};
+
+/**
+ * @brief Client whose output is captured in a buffer shared by all copies,
+ *        like the reference-counted connection of the real WiFiClient.
+ */
+class WiFiClient : public Print {
+public:
+    struct State {
+        std::string sent;
+        bool connected = true;
+        int window = 2920;  ///< Free TCP send buffer reported by availableForWrite()
+    };
+
+    WiFiClient() : _state(std::make_shared<State>()) {}
+
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t *data, size_t size) override {
+        if (!_state->connected) return 0;
+        _state->sent.append((const char *)data, size);
+        return size;
+    }
+    using Print::write;
+
+    int availableForWrite() { return _state->connected ? _state->window : 0; }
+    uint8_t connected() { return _state->connected; }
+    void stop() { _state->connected = false; }
+    void setNoDelay(bool) {}
+    void setSync(bool) {}
+
+    State &state() { return *_state; }
+
+private:
+    std::shared_ptr<State> _state;
+};
+
+typedef enum { WL_IDLE_STATUS = 0, WL_NO_SSID_AVAIL = 1, WL_CONNECTED = 3, WL_CONNECT_FAILED = 4, WL_DISCONNECTED = 6 } wl_status_t;
+
+typedef enum { WIFI_OFF = 0, WIFI_STA = 1, WIFI_AP = 2, WIFI_AP_STA = 3 } WiFiMode_t;
+
+namespace mock {
+inline wl_status_t wifiStatus = WL_CONNECTED;
+inline uint8_t wifiBssid[6] = {0x02, 0x11, 0x22, 0x33, 0x44, 0x55};
+inline int32_t wifiChannel = 6;
+inline unsigned long wifiBegins = 0;
+inline int32_t wifiBeginChannel = 0;  ///< Channel hint of the last begin()
+}
+
+class ESP8266WiFiClass {
+public:
+    bool config(IPAddress, IPAddress, IPAddress, IPAddress = IPAddress()) { return true; }
+    int begin(const char *, const char * = nullptr, int32_t channel = 0, const uint8_t * = nullptr, bool = true) {
+        mock::wifiBegins++;
+        mock::wifiBeginChannel = channel;
+        return mock::wifiStatus;
+    }
+    bool disconnect(bool = false) { return true; }
+    bool mode(WiFiMode_t) { return true; }
+    void persistent(bool) {}
+    bool setAutoReconnect(bool) { return true; }
+    wl_status_t status() { return mock::wifiStatus; }
+    uint8_t *BSSID() { return mock::wifiBssid; }
+    int32_t channel() { return mock::wifiChannel; }
+};
+
+inline ESP8266WiFiClass WiFi;
+
+#endif // MOCK_ESP8266_WIFI_H
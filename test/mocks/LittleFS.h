@@ -0,0 +1,191 @@
+/**
+ * @file LittleFS.h
+ * @brief Host stand-in for LittleFS backed by a directory on disk.
+ * @details Paths are resolved below mock::fsRoot, which the test sets with
+ *          LittleFS.setRoot() before calling into the firmware.
+ */
+
+#ifndef MOCK_LITTLEFS_H
+#define MOCK_LITTLEFS_H
+
+#include "Arduino.h"
+#include <filesystem>
+#include <memory>
+#include <vector>
+#include <unistd.h>
+
+namespace mock {
+/// Files opened for writing (each one is at least one flash write on the device)
+inline unsigned long fileWrites = 0;
+/// File handles currently open (each holds a buffer on the device heap)
+inline long openFiles = 0;
+/// Creating, appending to or writing a file fails, as on a full filesystem
+inline bool failWrites = false;
+/// Like failWrites, for the files whose path starts with this prefix only
+inline const char *failWritesTo = nullptr;
+/// Opens for writing refused by failWrites or failWritesTo
+inline unsigned long refusedWrites = 0;
+/// Partition size reported by LittleFS.info() (FS_PHYS_SIZE of the 4m2m layout)
+inline size_t fsTotalBytes = 0x1FA000;
+}
+
+/**
+ * @brief Filesystem usage as reported by LittleFS.info().
+ */
+struct FSInfo {
+    size_t totalBytes;
+    size_t usedBytes;
+    size_t blockSize;
+    size_t pageSize;
+    size_t maxOpenFiles;
+    size_t maxPathLength;
+};
+
+class File : public Print {
+public:
+    File() {}
+    File(FILE *f, const std::string &name) : _f(f, [](FILE *p) { fclose(p); mock::openFiles--; }) {
+        mock::openFiles++;
+        // Fixed buffer: the heap figures must not depend on the host's
+        // short-string limit.
+        snprintf(_name, sizeof(_name), "%s", name.c_str());
+    }
+
+    explicit operator bool() const { return (bool)_f; }
+
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t *data, size_t size) override {
+        return _f && !mock::failWrites ? fwrite(data, 1, size, _f.get()) : 0;
+    }
+    using Print::write;
+
+    size_t read(uint8_t *data, size_t size) { return _f ? fread(data, 1, size, _f.get()) : 0; }
+    int read() {
+        uint8_t c;
+        return read(&c, 1) == 1 ? c : -1;
+    }
+    size_t readBytes(char *data, size_t size) { return read((uint8_t *)data, size); }
+    size_t readBytesUntil(char terminator, char *data, size_t size) {
+        size_t n = 0;
+        int c;
+        while (n < size && (c = read()) >= 0 && c != terminator) data[n++] = (char)c;
+        return n;
+    }
+
+    bool seek(uint32_t pos, SeekMode mode = SeekSet) {
+        int whence = mode == SeekSet ? SEEK_SET : mode == SeekCur ? SEEK_CUR : SEEK_END;
+        return _f && fseek(_f.get(), (long)pos, whence) == 0;
+    }
+    size_t position() const { return _f ? (size_t)ftell(_f.get()) : 0; }
+    size_t size() const {
+        if (!_f) return 0;
+        long cur = ftell(_f.get());
+        fseek(_f.get(), 0, SEEK_END);
+        long end = ftell(_f.get());
+        fseek(_f.get(), cur, SEEK_SET);
+        return (size_t)end;
+    }
+    int available() const { return (int)(size() - position()); }
+    void flush() override {
+        if (_f) fflush(_f.get());
+    }
+    bool truncate(uint32_t size) {
+        if (!_f) return false;
+        fflush(_f.get());
+        return ftruncate(fileno(_f.get()), (off_t)size) == 0;
+    }
+    void close() { _f.reset(); }
+    const char *name() const { return _name; }
+
+private:
+    std::shared_ptr<FILE> _f;
+    char _name[48] = {0};
+};
+
+class Dir {
+public:
+    Dir() {}
+    explicit Dir(const std::string &path) {
+        std::error_code ec;
+        for (const auto &e : std::filesystem::directory_iterator(path, ec)) {
+            if (e.is_regular_file()) _entries.push_back(e.path());
+        }
+    }
+    bool next() { return ++_pos < (int)_entries.size(); }
+    String fileName() const { return String(_entries[_pos].filename().string()); }
+    size_t fileSize() const { return (size_t)std::filesystem::file_size(_entries[_pos]); }
+
+private:
+    std::vector<std::filesystem::path> _entries;
+    int _pos = -1;
+};
+
+class FS {
+public:
+    void setRoot(const std::string &root) {
+        _root = root;
+        std::filesystem::create_directories(_root);
+    }
+
+    bool begin() { return true; }
+
+    File open(const char *path, const char *mode) {
+        const char *m = strcmp(mode, "r+") == 0 ? "r+b"
+                      : strcmp(mode, "w") == 0  ? "w+b"
+                      : strcmp(mode, "a") == 0  ? "a+b"
+                                                : "rb";
+        std::filesystem::path p = resolve(path);
+        if (mode[0] != 'r') std::filesystem::create_directories(p.parent_path());
+        if (strcmp(mode, "r") != 0) {
+            mock::fileWrites++;
+            bool fail = mock::failWrites ||
+                        (mock::failWritesTo != nullptr && strncmp(path, mock::failWritesTo, strlen(mock::failWritesTo)) == 0);
+            if (fail && mode[0] != 'r') {
+                mock::refusedWrites++;
+                return File();
+            }
+        }
+        FILE *f = fopen(p.c_str(), m);
+        return f ? File(f, path) : File();
+    }
+    bool exists(const char *path) { return std::filesystem::exists(resolve(path)); }
+    bool remove(const char *path) {
+        std::error_code ec;
+        return std::filesystem::remove(resolve(path), ec);
+    }
+    bool rename(const char *from, const char *to) {
+        std::error_code ec;
+        std::filesystem::rename(resolve(from), resolve(to), ec);
+        return !ec;
+    }
+    bool mkdir(const char *path) {
+        std::error_code ec;
+        std::filesystem::create_directories(resolve(path), ec);
+        return !ec;
+    }
+    Dir openDir(const char *path) { return Dir(resolve(path).string()); }
+
+    /**
+     * @brief Usage counted as LittleFS does: whole 8 KB blocks per file and
+     *        a metadata pair per directory.
+     */
+    bool info(FSInfo &info) {
+        const size_t block = 8192;
+        info = {mock::fsTotalBytes, 2 * block, block, 256, 5, 32};
+        std::error_code ec;
+        for (const auto &e : std::filesystem::recursive_directory_iterator(_root, ec)) {
+            if (e.is_directory()) info.usedBytes += 2 * block;
+            else if (e.is_regular_file()) info.usedBytes += (e.file_size() + block - 1) / block * block;
+        }
+        return true;
+    }
+
+private:
+    std::filesystem::path resolve(const char *path) const { return _root / (path[0] == '/' ? path + 1 : path); }
+
+    std::filesystem::path _root = "littlefs";
+};
+
+inline FS LittleFS;
+
+#endif // MOCK_LITTLEFS_H
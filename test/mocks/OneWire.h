@@ -0,0 +1,19 @@
+/**
+ * @file OneWire.h
+ * @brief Host stand-in for the OneWire bus.
+ */
+
+#ifndef MOCK_ONEWIRE_H
+#define MOCK_ONEWIRE_H
+
+#include "Arduino.h"
+
+class OneWire {
+public:
+    explicit OneWire(uint8_t pin) : _pin(pin) {}
+
+private:
+    uint8_t _pin;
+};
+
+#endif // MOCK_ONEWIRE_H
@@ -0,0 +1,69 @@
+/**
+ * @file RTClib.h
+ * @brief Host stand-in for RTClib's DateTime and RTC_DS3231.
+ */
+
+#ifndef MOCK_RTCLIB_H
+#define MOCK_RTCLIB_H
+
+#include "Arduino.h"
+#include <time.h>
+
+class DateTime {
+public:
+    DateTime(uint32_t t = 0) : _t(t) {
+        time_t tt = (time_t)t;
+        gmtime_r(&tt, &_tm);
+    }
+    DateTime(uint16_t y, uint8_t m, uint8_t d, uint8_t hh = 0, uint8_t mm = 0, uint8_t ss = 0) {
+        struct tm tm = {};
+        tm.tm_year = y - 1900;
+        tm.tm_mon = m - 1;
+        tm.tm_mday = d;
+        tm.tm_hour = hh;
+        tm.tm_min = mm;
+        tm.tm_sec = ss;
+        _t = (uint32_t)timegm(&tm);
+        _tm = tm;
+    }
+
+    uint16_t year() const { return _tm.tm_year + 1900; }
+    uint8_t month() const { return _tm.tm_mon + 1; }
+    uint8_t day() const { return _tm.tm_mday; }
+    uint8_t hour() const { return _tm.tm_hour; }
+    uint8_t minute() const { return _tm.tm_min; }
+    uint8_t second() const { return _tm.tm_sec; }
+    uint32_t unixtime() const { return _t; }
+
+private:
+    uint32_t _t;
+    struct tm _tm;
+};
+
+/**
+ * @brief RTC whose time is set by the test (mock::rtcTime).
+ */
+namespace mock {
+inline uint32_t rtcTime = 1735689600; // 2025-01-01 00:00:00
+inline bool rtcLostPower = false;     ///< Oscillator stopped; cleared by adjust()
+inline uint8_t rtcGlitches = 0;       ///< Readings still to come back garbled
+}
+
+class RTC_DS3231 {
+public:
+    bool begin() { return true; }
+    bool lostPower() { return mock::rtcLostPower; }
+    DateTime now() {
+        if (mock::rtcGlitches > 0) {
+            mock::rtcGlitches--;
+            return DateTime(mock::rtcTime ^ 0x40000000);
+        }
+        return DateTime(mock::rtcTime);
+    }
+    void adjust(const DateTime &dt) {
+        mock::rtcTime = dt.unixtime();
+        mock::rtcLostPower = false;
+    }
+};
+
+#endif // MOCK_RTCLIB_H
@@ -0,0 +1,22 @@
+/**
+ * @file TM1637Display.h
+ * @brief Host stand-in for the TM1637 7-segment driver.
+ */
+
+#ifndef MOCK_TM1637_DISPLAY_H
+#define MOCK_TM1637_DISPLAY_H
+
+#include "Arduino.h"
+
+namespace mock {
+inline int displayValue = 0;
+}
+
+class TM1637Display {
+public:
+    TM1637Display(uint8_t, uint8_t) {}
+    void setBrightness(uint8_t, bool = true) {}
+    void showNumberDecEx(int num, uint8_t = 0, bool = false, uint8_t = 4, uint8_t = 0) { mock::displayValue = num; }
+};
+
+#endif // MOCK_TM1637_DISPLAY_H
@@ -0,0 +1,18 @@
+/**
+ * @file Wire.h
+ * @brief Host stand-in for the I2C bus.
+ */
+
+#ifndef MOCK_WIRE_H
+#define MOCK_WIRE_H
+
+#include "Arduino.h"
+
+class TwoWire {
+public:
+    void begin(int, int) {}
+};
+
+inline TwoWire Wire;
+
+#endif // MOCK_WIRE_H
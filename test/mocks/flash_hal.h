@@ -0,0 +1,18 @@
+/**
+ * @file flash_hal.h
+ * @brief Host stand-in for the flash layout macros of the ESP8266 core.
+ * @details Mirrors the 4 MB layout with a 2 MB file system: the file system
+ *          ends on a block boundary, one spare sector before the EEPROM
+ *          sector.
+ */
+
+#ifndef MOCK_FLASH_HAL_H
+#define MOCK_FLASH_HAL_H
+
+#include "Arduino.h"
+
+#define FS_PHYS_SIZE 0x1FA000
+#define FS_PHYS_ADDR \
+    ((uint32_t)((uintptr_t)&_EEPROM_start - 0x40200000) / SPI_FLASH_SEC_SIZE * SPI_FLASH_SEC_SIZE - SPI_FLASH_SEC_SIZE - FS_PHYS_SIZE)
+
+#endif // MOCK_FLASH_HAL_H
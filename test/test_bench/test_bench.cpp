@@ -0,0 +1,1233 @@
+/**
+ * @file test_bench.cpp
+ * @brief Host benchmark for the logging and history paths.
+ * @details Builds logs covering 1 day, 30 days and 1 year of one-minute
+ *          samples (cumulatively, in one LittleFS directory) and reports the
+ *          time per call and the peak heap allocation of the hot paths.
+ *          Run with `pio test -e native -v` to see the report.
+ */
+
+#include <unity.h>
+#include <new>
+#include <algorithm>
+#include <vector>
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <ESP8266WebServer.h>
+#include <RTClib.h>
+#include <DallasTemperature.h>
+#include "LogHelper.h"
+#include "LogStore.h"
+#include "TimeIndex.h"
+#include "Rollup.h"
+#include "DayArchive.h"
+#include "FixedPoint.h"
+#include "StreamJob.h"
+#include "Metrics.h"
+#include "EventStream.h"
+#include "ConfigStore.h"
+#include "WifiLink.h"
+#include "BootTrace.h"
+#include "SensorHelper.h"
+
+extern ESP8266WebServer server;
+extern int16_t currentTemps[];
+extern SystemConfig config;
+extern DallasTemperature sensors;
+void setup();
+void loop();
+int buildEventFrame(uint8_t s, char *buf, size_t size);
+void sensorAssigned(uint8_t slot, bool reused);
+void logSample();
+uint32_t logTime();
+
+// --- Allocation tracking ---
+
+static size_t heapCurrent = 0;
+static size_t heapPeak = 0;
+
+void *operator new(size_t size) {
+    size_t *p = (size_t *)malloc(size + sizeof(size_t));
+    if (p == nullptr) throw std::bad_alloc();
+    *p = size;
+    heapCurrent += size;
+    if (heapCurrent > heapPeak) heapPeak = heapCurrent;
+    return p + 1;
+}
+
+void operator delete(void *ptr) noexcept {
+    if (ptr == nullptr) return;
+    size_t *p = (size_t *)ptr - 1;
+    heapCurrent -= *p;
+    free(p);
+}
+
+void operator delete(void *ptr, size_t) noexcept { operator delete(ptr); }
+
+static void resetPeak() { heapPeak = heapCurrent; }
+static size_t peakSinceReset(size_t base) { return heapPeak - base; }
+
+// --- Helpers ---
+
+/**
+ * @brief Print sink that only counts bytes.
+ */
+class NullPrint : public Print {
+public:
+    size_t written = 0;
+    size_t write(uint8_t) override { written++; return 1; }
+    size_t write(const uint8_t *, size_t size) override { written += size; return size; }
+};
+
+/**
+ * @brief Print sink that keeps the text.
+ */
+class StringPrint : public Print {
+public:
+    std::string text;
+    size_t write(uint8_t c) override { text.push_back((char)c); return 1; }
+    size_t write(const uint8_t *p, size_t size) override { text.append((const char *)p, size); return size; }
+};
+
+/**
+ * @brief Issues a request and, if the route handed the client to a stream
+ *        job, runs the job to completion and decodes the raw response.
+ */
+static ESP8266WebServer::Response streamRequest(const char *uri, const std::map<std::string, std::string> &args) {
+    ESP8266WebServer::Response r = server.request(uri, args);
+    if (r.code != 0) return r;
+
+    WiFiClient client = server.lastClient();
+    while (streamRun(millis())) {}
+    const std::string &raw = client.state().sent;
+    size_t headEnd = raw.find("\r\n\r\n");
+    r.code = atoi(raw.c_str() + 9);
+    for (size_t p = raw.find("\r\n") + 2; p < headEnd;) {
+        size_t eol = raw.find("\r\n", p);
+        size_t colon = raw.find(": ", p);
+        r.headers[raw.substr(p, colon - p)] = raw.substr(colon + 2, eol - colon - 2);
+        p = eol + 2;
+    }
+    r.contentType = r.headers["Content-Type"];
+    for (size_t p = headEnd + 4; p < raw.size();) {
+        size_t len = strtoul(raw.c_str() + p, nullptr, 16);
+        p = raw.find("\r\n", p) + 2;
+        r.body.append(raw, p, len);
+        r.chunks += len > 0;
+        p += len + 2;
+    }
+    return r;
+}
+
+struct Result {
+    const char *name;
+    double usPerCall;
+    size_t peakBytes;
+};
+
+struct Dataset {
+    const char *name;
+    uint32_t days;
+    std::vector<Result> results;
+};
+
+static Dataset datasets[] = {
+    {"1 day", 1, {}},
+    {"30 days", 30, {}},
+    {"1 year", 365, {}},
+};
+
+static const uint32_t START_TIME = 1704067200; // 2024-01-01 00:00:00
+static uint32_t generatedMinutes = 0;
+static double fileWritesPerDay = 0;  ///< Over the last generate() call, archive seals included
+
+template <typename Fn>
+static Result measure(const char *name, int iterations, Fn fn) {
+    size_t base = heapCurrent;
+    resetPeak();
+    unsigned long start = micros();
+    for (int i = 0; i < iterations; i++) fn();
+    unsigned long elapsed = micros() - start;
+    return {name, (double)elapsed / iterations, peakSinceReset(base)};
+}
+
+static int16_t generatedCenti(uint32_t minute) {
+    return (int16_t)lroundf(2200.0f + 300.0f * sinf(minute / 240.0f));
+}
+
+/**
+ * @brief Extends the log up to `days` of one-minute samples. Finished
+ *        days are sealed into the archive between days, as the archive
+ *        task does on the device; only the appends are timed.
+ */
+static Result generate(uint32_t days) {
+    uint32_t target = days * 1440;
+    uint32_t n = target - generatedMinutes;
+    unsigned long writes = mock::fileWrites;
+    Result total = {"appendLog", 0, 0};
+    while (generatedMinutes < target) {
+        uint32_t dayEnd = std::min(target, (generatedMinutes / 1440 + 1) * 1440);
+        Result r = measure("appendLog", 1, [&]() {
+            for (; generatedMinutes < dayEnd; generatedMinutes++) {
+                uint32_t t = START_TIME + generatedMinutes * 60;
+                appendLog(0, t, generatedCenti(generatedMinutes));
+            }
+        });
+        total.usPerCall += r.usPerCall;
+        total.peakBytes = std::max(total.peakBytes, r.peakBytes);
+        while (logArchive()) {}
+    }
+    total.usPerCall /= n;
+    fileWritesPerDay = (double)(mock::fileWrites - writes) * 1440 / n;
+    mock::rtcTime = START_TIME + generatedMinutes * 60;
+    return total;
+}
+
+static void runDataset(Dataset &d) {
+    d.results.push_back(generate(d.days));
+
+    d.results.push_back(measure("getLogStats", 1000, []() {
+        int lines, size;
+        getLogStats(lines, size);
+    }));
+    d.results.push_back(measure("GET /status", 1000, []() { server.request("/status"); }));
+
+    static const char *const names[] = {"writeHistoryJson m=1", "writeHistoryJson m=2", "writeHistoryJson m=3"};
+    for (int mode = 1; mode <= 3; mode++) {
+        d.results.push_back(measure(names[mode - 1], 200, [mode]() {
+            NullPrint out;
+            writeHistoryJson(0, mode, mock::rtcTime, false, out);
+        }));
+    }
+    d.results.push_back(measure("writeHistoryJson m=3 st", 200, []() {
+        NullPrint out;
+        writeHistoryJson(0, 3, mock::rtcTime, true, out);
+    }));
+    d.results.push_back(measure("GET /get_hist m=3", 200, []() { streamRequest("/get_hist", {{"m", "3"}}); }));
+    d.results.push_back(measure("writeHistorySvg m=3", 200, []() {
+        NullPrint out;
+        writeHistorySvg(0, 3, mock::rtcTime, out);
+    }));
+
+    // Whole-log exports: one call streams every stored record.
+    d.results.push_back(measure("writeExport csv", 3, []() {
+        NullPrint out;
+        writeExport(0, 0, UINT32_MAX, 0, false, out);
+    }));
+    d.results.push_back(measure("writeExport bin", 3, []() {
+        NullPrint out;
+        writeExport(0, 0, UINT32_MAX, 0, true, out);
+    }));
+    d.results.push_back(measure("writeExport csv 1h", 3, []() {
+        NullPrint out;
+        writeExport(0, 0, UINT32_MAX, 3600, false, out);
+    }));
+
+    // 30 days read from the ring, and 30 days from before it (the archive,
+    // once the log is older than the ring).
+    d.results.push_back(measure("writeExport bin last 30d", 3, []() {
+        NullPrint out;
+        writeExport(0, mock::rtcTime - 30 * 86400, UINT32_MAX, 0, true, out);
+    }));
+    d.results.push_back(measure("writeExport bin 30d old", 3, []() {
+        NullPrint out;
+        writeExport(0, mock::rtcTime - 90 * 86400, mock::rtcTime - 60 * 86400, 0, true, out);
+    }));
+}
+
+static const Result &find(const Dataset &d, const char *name) {
+    for (const auto &r : d.results) {
+        if (strcmp(r.name, name) == 0) return r;
+    }
+    TEST_FAIL_MESSAGE(name);
+    return d.results[0];
+}
+
+static void report() {
+    printf("\n%-24s", "benchmark");
+    for (const auto &d : datasets) printf(" | %10s us %9s B", d.name, "peak");
+    printf("\n");
+    for (size_t i = 0; i < datasets[0].results.size(); i++) {
+        printf("%-24s", datasets[0].results[i].name);
+        for (const auto &d : datasets) printf(" | %13.2f %11zu", d.results[i].usPerCall, d.results[i].peakBytes);
+        printf("\n");
+    }
+}
+
+// --- Tests ---
+
+static long diagValue(const std::string &body, const char *key) {
+    size_t p = body.find(key);
+    return p == std::string::npos ? -1 : atol(body.c_str() + p + strlen(key));
+}
+
+void test_boot_does_not_wait_for_wifi() {
+    // setup() ran with the access point out of reach
+    TEST_ASSERT_FALSE(wifiConnected());
+    unsigned long start = millis();
+    while (!bootReached("firstSample") && millis() - start < 2000) loop();
+    int lines, size;
+    getLogStats(lines, size);
+    TEST_ASSERT_EQUAL(1, lines);
+
+    ESP8266WebServer::Response r = server.request("/diag");
+    long firstSample = diagValue(r.body, "\"firstSample\":");
+    printf("\nboot: first sample after %ld ms, Wi-Fi down\n%s\n", firstSample,
+           r.body.substr(0, r.body.find(",\"scheduler\"")).c_str());
+    TEST_ASSERT_TRUE(firstSample >= 0 && firstSample < 1000);
+    TEST_ASSERT_EQUAL(-1, diagValue(r.body, "\"server\":"));
+
+    // The link comes up later: the server starts and the access point is cached
+    mock::wifiStatus = WL_CONNECTED;
+    start = millis();
+    while (!wifiConnected() && millis() - start < 1000) loop();
+    r = server.request("/diag");
+    TEST_ASSERT_TRUE(diagValue(r.body, "\"server\":") >= firstSample);
+    TEST_ASSERT_EQUAL(mock::wifiChannel, config.wifiChannel);
+    TEST_ASSERT_EQUAL(0, memcmp(config.wifiBssid, mock::wifiBssid, 6));
+
+    server.request("/clear_log");
+}
+
+void test_generate_and_measure() {
+    for (auto &d : datasets) runDataset(d);
+    report();
+
+    int lines, size;
+    getLogStats(lines, size);
+    TEST_ASSERT_EQUAL_UINT32(LOG_CAPACITY, (uint32_t)lines);
+    const LogMeta &meta = getLogMeta(0);
+    TEST_ASSERT_EQUAL_UINT32(meta.lastTime - (LOG_CAPACITY - 1) * 60, meta.firstTime);
+
+    // Per day of one-minute samples: 72 raw batches, 24 writes of the
+    // 5-minute tier, a few of the other tiers, the index and the summary,
+    // and the archive seal. The unbatched log wrote once per sample.
+    printf("\nflash: %.1f file writes per day (%.1fx fewer than one per sample)\n", fileWritesPerDay,
+           1440 / fileWritesPerDay);
+    TEST_ASSERT_TRUE(fileWritesPerDay * 10 <= 1440);
+}
+
+void test_status_is_independent_of_log_size() {
+    double small = find(datasets[0], "GET /status").usPerCall;
+    double large = find(datasets[2], "GET /status").usPerCall;
+    TEST_ASSERT_TRUE_MESSAGE(large < small * 3 + 20, "/status latency grows with log size");
+}
+
+void test_history_heap_is_constant() {
+    // Reads hold one file handle (none while a tier is still empty, as the
+    // daily tier is after one day), whatever the log size.
+    for (const char *name : {"writeHistoryJson m=1", "writeHistoryJson m=2", "writeHistoryJson m=3", "writeHistoryJson m=3 st",
+                             "writeHistorySvg m=3"}) {
+        TEST_ASSERT_EQUAL_MESSAGE(find(datasets[1], name).peakBytes, find(datasets[2], name).peakBytes, name);
+    }
+    // Exports past the ring read the archive first and close it before the
+    // ring takes over: still one handle at a time, whatever the range.
+    for (const char *name : {"writeExport csv", "writeExport bin", "writeExport csv 1h", "writeExport bin last 30d",
+                             "writeExport bin 30d old"}) {
+        TEST_ASSERT_EQUAL_MESSAGE(find(datasets[0], name).peakBytes, find(datasets[2], name).peakBytes, name);
+    }
+    TEST_ASSERT_EQUAL(0, mock::openFiles);
+}
+
+void test_history_returns_bins() {
+    ESP8266WebServer::Response r = streamRequest("/get_hist", {{"m", "2"}});
+    TEST_ASSERT_EQUAL(200, r.code);
+    TEST_ASSERT_EQUAL('[', r.body.front());
+    TEST_ASSERT_EQUAL(']', r.body.back());
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, r.body.find("\"t\":"));
+}
+
+void test_history_stats_envelope() {
+    ESP8266WebServer::Response r = streamRequest("/get_hist", {{"m", "2"}, {"stats", "1"}});
+    TEST_ASSERT_EQUAL(200, r.code);
+
+    // Hourly bins of a sine with a 4 h period: every bin has spread.
+    float t, mn, mx, sd;
+    unsigned n;
+    size_t p = r.body.find("\"t\":");
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, p);
+    TEST_ASSERT_EQUAL(5, sscanf(r.body.c_str() + p, "\"t\":%f,\"mn\":%f,\"mx\":%f,\"sd\":%f,\"n\":%u", &t, &mn, &mx, &sd, &n));
+    TEST_ASSERT_EQUAL(60, n);
+    TEST_ASSERT_TRUE(mn <= t && t <= mx);
+    TEST_ASSERT_TRUE(sd > 0.1f && sd < (mx - mn));
+
+    r = streamRequest("/get_hist", {{"m", "2"}});
+    TEST_ASSERT_EQUAL(std::string::npos, r.body.find("\"sd\":"));
+}
+
+static size_t countOf(const std::string &body, const char *needle) {
+    size_t n = 0;
+    for (size_t p = body.find(needle); p != std::string::npos; p = body.find(needle, p + 1)) n++;
+    return n;
+}
+
+void test_history_chart_is_self_contained() {
+    ESP8266WebServer::Response json = streamRequest("/get_hist", {{"m", "2"}});
+    ESP8266WebServer::Response r = server.request("/chart.svg", {{"m", "2"}});
+    TEST_ASSERT_EQUAL(200, r.code);
+    TEST_ASSERT_EQUAL_STRING("image/svg+xml", r.contentType.c_str());
+    TEST_ASSERT_EQUAL(0, r.body.find("<svg xmlns=\"http://www.w3.org/2000/svg\""));
+    TEST_ASSERT_EQUAL(r.body.size() - 6, r.body.rfind("</svg>"));
+    // One marker per JSON bin, plus the envelope and the average line
+    TEST_ASSERT_EQUAL(countOf(json.body, "\"t\":"), countOf(r.body, "<circle"));
+    TEST_ASSERT_EQUAL(1, countOf(r.body, "<polygon class=\"band\""));
+    TEST_ASSERT_EQUAL(1, countOf(r.body, "<polyline class=\"avg\""));
+    TEST_ASSERT_EQUAL(1, countOf(r.body, "http"));
+
+    // No log for this sensor: an empty chart, not an error
+    r = server.request("/chart.svg", {{"s", "3"}, {"m", "2"}});
+    TEST_ASSERT_EQUAL(200, r.code);
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, r.body.find("No data"));
+
+    r = server.request("/history");
+    TEST_ASSERT_EQUAL(200, r.code);
+    printf("\nchart: %zu bytes for %zu daily-view bins (JSON %zu bytes)\n", server.request("/chart.svg", {{"m", "2"}}).body.size(),
+           countOf(json.body, "\"t\":"), json.body.size());
+}
+
+void test_fixed_point_round_trip() {
+    char buf[12];
+    formatCenti(buf, -105);
+    TEST_ASSERT_EQUAL_STRING("-1.05", buf);
+    formatCenti(buf, 2444, 1);
+    TEST_ASSERT_EQUAL_STRING("24.4", buf);
+    formatCenti(buf, 2445, 1);
+    TEST_ASSERT_EQUAL_STRING("24.5", buf);
+    formatCenti(buf, -4, 1);
+    TEST_ASSERT_EQUAL_STRING("0.0", buf);
+    TEST_ASSERT_EQUAL(2475, parseCenti("24.75"));
+    TEST_ASSERT_EQUAL(-350, parseCenti("-3.5"));
+    TEST_ASSERT_EQUAL(2500, parseCenti("24.996"));
+    TEST_ASSERT_EQUAL(INT16_MIN, parseCenti("abc"));
+    TEST_ASSERT_EQUAL(2450, rawToCenti(24.5 * 128));
+    TEST_ASSERT_EQUAL(-12700, rawToCenti(-127 * 128));
+
+    // Per-record cost of the history formatter: fixed-point vs. float printf.
+    const int n = 44640;
+    volatile size_t sink = 0;
+    Result fixed = measure("formatCenti", 1, [&]() {
+        for (int i = 0; i < n; i++) sink += formatCenti(buf, (int16_t)(i % 8000 - 2000));
+    });
+    Result soft = measure("snprintf %.2f", 1, [&]() {
+        for (int i = 0; i < n; i++) sink += snprintf(buf, sizeof(buf), "%.2f", (i % 8000 - 2000) / 100.0f);
+    });
+    printf("\nformat per record: fixed %.3f us, float %.3f us\n", fixed.usPerCall / n, soft.usPerCall / n);
+    TEST_ASSERT_TRUE(fixed.usPerCall < soft.usPerCall);
+}
+
+void test_index_points_at_bucket_start() {
+    logFlush();
+    const LogMeta &meta = getLogMeta(0);
+    TimeIndex index;
+    TEST_ASSERT_TRUE(index.begin("/log0/idx", LOG_INDEX_BUCKET, LOG_INDEX_CAPACITY));
+
+    // One-minute samples: the record for a bucket start is (start - first) / 60 past the oldest.
+    uint32_t ts = meta.firstTime + 3 * 86400 + 1234;
+    uint32_t seq;
+    TEST_ASSERT_TRUE(index.lookup(ts, seq));
+    uint32_t bucket = ts - ts % LOG_INDEX_BUCKET;
+    TEST_ASSERT_EQUAL_UINT32(meta.written - meta.count + (bucket - meta.firstTime) / 60, seq);
+    TEST_ASSERT_FALSE(index.lookup(meta.firstTime - 2 * LOG_INDEX_BUCKET, seq) && seq >= meta.written - meta.count);
+}
+
+void test_ring_is_segmented() {
+    // Appends only ever fill small files: none larger than a LittleFS block,
+    // and no more than one segment beyond the capacity in total
+    size_t bytes = 0, largest = 0;
+    for (const auto &e : std::filesystem::directory_iterator(".pio/bench_fs/log0")) {
+        if (e.path().filename().string().rfind("raw", 0) != 0) continue;
+        bytes += e.file_size();
+        largest = std::max(largest, (size_t)e.file_size());
+    }
+    TEST_ASSERT_TRUE(largest <= 8192);
+    TEST_ASSERT_TRUE(bytes <= LOG_CAPACITY * sizeof(LogRecord) + 2 * 8192);
+
+    RingLog ring;
+    TEST_ASSERT_TRUE(ring.begin("/ringtest/r", sizeof(LogRecord), 3000));
+    LogRecord recs[7];
+    for (uint32_t t = 0; t < 5005; t += 7) {
+        for (uint32_t i = 0; i < 7; i++) recs[i] = {t + i, (int16_t)(t + i)};
+        TEST_ASSERT_TRUE(ring.append(recs, 7));
+    }
+    TEST_ASSERT_EQUAL_UINT32(3000, ring.count());
+    TEST_ASSERT_EQUAL(1, ring.read(0, recs, 1));
+    TEST_ASSERT_EQUAL_UINT32(2005, recs[0].timestamp);
+    TEST_ASSERT_EQUAL_UINT32(2495, ring.lowerBound(4500));
+
+    // A record torn by a power loss is cut off when the ring is opened
+    uint32_t newest = 0;
+    for (const auto &e : std::filesystem::directory_iterator(".pio/bench_fs/ringtest")) {
+        newest = std::max(newest, (uint32_t)atol(e.path().filename().c_str() + 1));
+    }
+    File f = LittleFS.open(("/ringtest/r" + std::to_string(newest) + ".bin").c_str(), "a");
+    f.write((const uint8_t *)"\x01\x02\x03", 3);
+    f.close();
+    TEST_ASSERT_TRUE(ring.begin("/ringtest/r", sizeof(LogRecord), 3000));
+    TEST_ASSERT_EQUAL_UINT32(3000, ring.count());
+    recs[0] = {6000, 1};
+    TEST_ASSERT_TRUE(ring.append(recs, 1));
+    TEST_ASSERT_EQUAL(2, ring.read(2998, recs, 2));
+    TEST_ASSERT_EQUAL_UINT32(5004, recs[0].timestamp);
+    TEST_ASSERT_EQUAL_UINT32(6000, recs[1].timestamp);
+
+    // The preallocated ring file of earlier firmware is taken over in order
+    struct __attribute__((packed)) {
+        uint32_t magic, capacity, head, count;
+    } legacy = {0x474F4C52, 100, 20, 100};
+    uint16_t layout[2] = {1, sizeof(LogRecord)};
+    f = LittleFS.open("/legacy.bin", "w");
+    f.write((const uint8_t *)&legacy.magic, 4);
+    f.write((const uint8_t *)layout, sizeof(layout));
+    f.write((const uint8_t *)&legacy.capacity, 12);
+    for (uint32_t slot = 0; slot < 100; slot++) {
+        LogRecord rec = {(slot + 80) % 100, 0};  // Oldest at the head slot
+        f.write((const uint8_t *)&rec, sizeof(rec));
+    }
+    f.close();
+    TEST_ASSERT_TRUE(ring.migrate("/legacy.bin"));
+    TEST_ASSERT_FALSE(LittleFS.exists("/legacy.bin"));
+    TEST_ASSERT_EQUAL_UINT32(100, ring.count());
+    for (uint32_t i = 0; i < 100; i++) {
+        TEST_ASSERT_EQUAL(1, ring.read(i, recs, 1));
+        TEST_ASSERT_EQUAL_UINT32(i, recs[0].timestamp);
+    }
+    ring.clear();
+    TEST_ASSERT_EQUAL_UINT32(0, ring.count());
+}
+
+void test_export_range_and_step() {
+    const LogMeta &meta = getLogMeta(0);
+    uint32_t from = meta.lastTime - meta.lastTime % 86400 - 86400;  // Start of yesterday
+    std::string f = std::to_string(from), t = std::to_string(from + 3599);
+
+    ESP8266WebServer::Response r = streamRequest("/export", {{"from", f}, {"to", t}});
+    TEST_ASSERT_EQUAL(200, r.code);
+    TEST_ASSERT_EQUAL_STRING("text/csv", r.contentType.c_str());
+    TEST_ASSERT_EQUAL(0, r.body.find("time,temp\n" + f + ","));
+    TEST_ASSERT_EQUAL(61, std::count(r.body.begin(), r.body.end(), '\n'));
+
+    r = streamRequest("/export", {{"from", f}, {"to", std::to_string(from + 86399)}, {"step", "3600"}, {"format", "bin"}});
+    TEST_ASSERT_EQUAL_STRING("application/octet-stream", r.contentType.c_str());
+    TEST_ASSERT_EQUAL(24 * sizeof(ExportBin), r.body.size());
+    ExportBin bin;
+    memcpy(&bin, r.body.data() + sizeof(ExportBin), sizeof(bin));
+    TEST_ASSERT_EQUAL_UINT32(from + 3600, bin.start);
+    TEST_ASSERT_TRUE(bin.min <= bin.avg && bin.avg <= bin.max);
+
+    NullPrint out;
+    // The archive holds every day that left the ring
+    TEST_ASSERT_EQUAL_UINT32(generatedMinutes, writeExport(0, 0, UINT32_MAX, 0, true, out));
+    TEST_ASSERT_EQUAL(generatedMinutes * sizeof(LogRecord), out.written);
+    TEST_ASSERT_EQUAL(400, server.request("/export", {{"from", t}, {"to", f}}).code);
+}
+
+void test_archive_is_compact_and_lossless() {
+    logFlush();
+    size_t bytes = 0, files = 0;
+    for (const auto &e : std::filesystem::directory_iterator(".pio/bench_fs/log0")) {
+        if (e.path().filename().string().rfind("arc", 0) != 0) continue;
+        bytes += e.file_size();
+        files++;
+    }
+
+    // Every archived sample decodes to exactly what was logged
+    DayArchive archive;
+    TEST_ASSERT_TRUE(archive.begin("/log0/arc"));
+    ArchiveCursor cur;
+    TEST_ASSERT_TRUE(archive.rewind(cur, 0));
+    LogRecord chunk[32];
+    uint32_t samples = 0;
+    size_t n;
+    while ((n = archive.read(cur, 0, chunk, 32)) > 0) {
+        for (size_t i = 0; i < n; i++, samples++) {
+            TEST_ASSERT_EQUAL_UINT32(START_TIME + samples * 60, chunk[i].timestamp);
+            TEST_ASSERT_EQUAL(generatedCenti(samples), chunk[i].centi);
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(generatedMinutes / 1440 - 1, samples / 1440);  // All but the open day
+
+    NullPrint csv;
+    writeExport(0, 0, START_TIME + samples * 60 - 1, 0, false, csv);
+    printf("\narchive: %u days in %zu files, %zu bytes, %.2f bytes/sample (%.1fx denser than LogRecord, %.1fx than CSV)\n",
+           samples / 1440, files, bytes, (double)bytes / samples, (double)samples * sizeof(LogRecord) / bytes,
+           (double)csv.written / bytes);
+    TEST_ASSERT_TRUE(bytes * 5 <= samples * sizeof(LogRecord));
+    TEST_ASSERT_TRUE(files <= LOG_ARCHIVE_FILES);
+
+    // An export across the oldest ring record joins archive and ring seamlessly
+    const LogMeta &meta = getLogMeta(0);
+    std::vector<LogRecord> recs(120);
+    std::string body = streamRequest("/export", {{"from", std::to_string(meta.firstTime - 3600)},
+                                                 {"to", std::to_string(meta.firstTime + 3599)},
+                                                 {"format", "bin"}}).body;
+    TEST_ASSERT_EQUAL(recs.size() * sizeof(LogRecord), body.size());
+    memcpy(recs.data(), body.data(), body.size());
+    for (size_t i = 0; i < recs.size(); i++) TEST_ASSERT_EQUAL_UINT32(meta.firstTime - 3600 + i * 60, recs[i].timestamp);
+
+    // A segment torn by a power loss is ignored
+    char path[32];
+    snprintf(path, sizeof(path), "/log0/arc%u.seg", (unsigned)(archive.nextDay() - 1) / LOG_ARCHIVE_FILE_DAYS);
+    File f = LittleFS.open(path, "a");
+    SegmentHeader torn = {};
+    f.write((const uint8_t *)&torn, sizeof(torn));
+    f.close();
+    DayArchive reopened;
+    TEST_ASSERT_TRUE(reopened.begin("/log0/arc"));
+    TEST_ASSERT_EQUAL_UINT32(archive.nextDay(), reopened.nextDay());
+
+    // Retention drops whole files, oldest first
+    DayArchive small;
+    small.begin("/arctest/a");
+    uint32_t firstDay = 20000;
+    for (uint32_t day = firstDay; day < firstDay + (LOG_ARCHIVE_FILES + 1) * LOG_ARCHIVE_FILE_DAYS; day++) {
+        TEST_ASSERT_TRUE(small.open(day));
+        small.add({day * 86400, 2000});
+        small.add({day * 86400 + 60, 2001});
+        TEST_ASSERT_TRUE(small.seal());
+    }
+    files = 0;
+    for (const auto &e : std::filesystem::directory_iterator(".pio/bench_fs/arctest")) files += e.is_regular_file();
+    TEST_ASSERT_EQUAL(LOG_ARCHIVE_FILES, files);
+    TEST_ASSERT_TRUE(small.rewind(cur, 0));
+    TEST_ASSERT_EQUAL(1, small.read(cur, 0, chunk, 1));
+    TEST_ASSERT_EQUAL_UINT32((firstDay / LOG_ARCHIVE_FILE_DAYS + 1) * LOG_ARCHIVE_FILE_DAYS * 86400, chunk[0].timestamp);
+    small.clear();
+}
+
+void test_staged_samples_survive_reset() {
+    logFlush();
+    uint32_t last = getLogMeta(0).lastTime;
+    uint32_t bin = last - last % 300 + 300;
+    uint32_t count = getLogMeta(0).count;
+
+    // Ten staged samples close two 5-minute bins before the reset
+    for (uint32_t t = bin + 180; t <= bin + 720; t += 60) appendLog(0, t, 2000);
+    logEnd();
+    TEST_ASSERT_TRUE(logBegin(1));
+    TEST_ASSERT_EQUAL_UINT32(bin + 720, getLogMeta(0).lastTime);
+    logFlush();
+    TEST_ASSERT_EQUAL_UINT32(std::min(count + 10, LOG_CAPACITY), getLogMeta(0).count);
+
+    // Each bin once, in order, holding only its own samples
+    StringPrint out;
+    writeHistoryJson(0, 1, bin + 720, true, out);
+    const std::string &body = out.text;
+    std::vector<std::string> starts;
+    std::vector<unsigned> counts;
+    for (size_t p = body.find("\"f\":\""); p != std::string::npos; p = body.find("\"f\":\"", p + 1)) {
+        starts.push_back(body.substr(p + 5, body.find('"', p + 5) - p - 5));
+        counts.push_back((unsigned)atol(body.c_str() + body.find("\"n\":", p) + 4));
+    }
+    TEST_ASSERT_TRUE(counts.size() >= 3);
+    std::vector<std::string> unique = starts;
+    std::sort(unique.begin(), unique.end());
+    TEST_ASSERT_TRUE(std::unique(unique.begin(), unique.end()) == unique.end());
+    TEST_ASSERT_EQUAL(2, counts[counts.size() - 3]);
+    TEST_ASSERT_EQUAL(5, counts[counts.size() - 2]);
+    TEST_ASSERT_EQUAL(3, counts[counts.size() - 1]);
+
+    // Samples on flash whose summary, index entries and tier bins were
+    // still in RAM at the reset: caught up from the ring
+    logFlush();
+    uint32_t t = getLogMeta(0).lastTime;
+    for (uint32_t i = 1; i <= 3 * LOG_FLUSH_SAMPLES; i++) appendLog(0, t + i * 60, i == 7 ? -450 : 2000);
+    LogMeta flushed = getLogMeta(0);
+    logEnd();
+    TEST_ASSERT_TRUE(logBegin(1));
+    const LogMeta &meta = getLogMeta(0);
+    TEST_ASSERT_EQUAL_UINT32(flushed.written, meta.written);
+    TEST_ASSERT_EQUAL_UINT32(flushed.count, meta.count);
+    TEST_ASSERT_EQUAL_UINT32(flushed.firstTime, meta.firstTime);
+    TEST_ASSERT_EQUAL_UINT32(t + 3 * LOG_FLUSH_SAMPLES * 60, meta.lastTime);
+    TEST_ASSERT_EQUAL(-450, meta.minCenti);
+    NullPrint rows;
+    TEST_ASSERT_EQUAL_UINT32(3 * LOG_FLUSH_SAMPLES, writeExport(0, t + 60, UINT32_MAX, 0, true, rows));
+    out.text.clear();
+    writeHistoryJson(0, 1, meta.lastTime, true, out);
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, out.text.find("\"mn\":-4.5"));
+}
+
+void test_log_fits_and_retries() {
+    // No file handle is held between calls: the rings share one reader that
+    // is released after use, and the archive opens its file only to read.
+    TEST_ASSERT_EQUAL(0, mock::openFiles);
+
+    // Only as many sensors are logged as fit with every ring full
+    logFlush();
+    logEnd();
+    size_t total = mock::fsTotalBytes;
+    mock::fsTotalBytes = 600 * 1024;
+    TEST_ASSERT_FALSE(logBegin(2));
+    appendLog(1, getLogMeta(0).lastTime, 2000);
+    TEST_ASSERT_FALSE(LittleFS.exists("/log1"));
+    mock::fsTotalBytes = total;
+    logEnd();
+    TEST_ASSERT_TRUE(logBegin(1));
+
+    // A failed flush keeps its samples and is retried after a delay, not
+    // on every sample
+    uint32_t t = getLogMeta(0).lastTime;
+    uint32_t written = getLogMeta(0).written;
+    mock::failWrites = true;
+    for (uint32_t i = 1; i <= LOG_FLUSH_SAMPLES; i++) appendLog(0, t + i * 60, 2000);
+    unsigned long writes = mock::fileWrites;
+    for (uint32_t i = 1; i <= 100; i++) appendLog(0, t + (LOG_FLUSH_SAMPLES + i) * 60, 2000);
+    TEST_ASSERT_EQUAL(writes, mock::fileWrites);
+    mock::failWrites = false;
+    mock::clockShiftMs += LOG_RETRY_MIN_MS;
+    appendLog(0, t + 200 * 60, 2000);
+    TEST_ASSERT_EQUAL_UINT32(written + LOG_FLUSH_SAMPLES, getLogMeta(0).written);
+    TEST_ASSERT_EQUAL_UINT32(t + 200 * 60, getLogMeta(0).lastTime);
+    logFlush();
+}
+
+void test_tier_bins_survive_failed_writes() {
+    // Closed bins that cannot be written stay staged for the next flush
+    RollupTier tier;
+    tier.begin("/tiertest/r", 300, 16);
+    mock::failWritesTo = "/tiertest";
+    for (uint32_t t = 0; t <= 3 * 300; t += 60) tier.add(START_TIME + t, 2000, 0);
+    TEST_ASSERT_FALSE(tier.flush());
+    TEST_ASSERT_EQUAL(3, tier.staged());
+    mock::failWritesTo = nullptr;
+    TEST_ASSERT_TRUE(tier.flush());
+    TEST_ASSERT_EQUAL(0, tier.staged());
+    TEST_ASSERT_EQUAL_UINT32(3, tier.count());
+    RollupRecord bins[3];
+    TEST_ASSERT_EQUAL(3, tier.read(0, bins, 3));
+    for (int i = 0; i < 3; i++) TEST_ASSERT_EQUAL_UINT32(START_TIME + i * 300, bins[i].start);
+    tier.clear();
+
+    // The log retries a failing tier after a delay, not with every batch
+    uint32_t t = getLogMeta(0).lastTime;
+    mock::failWritesTo = "/log0/r5m";
+    unsigned long refused = mock::refusedWrites;
+    for (uint32_t i = 1; i <= 6 * LOG_FLUSH_SAMPLES; i++) appendLog(0, t + i * 60, 2000);
+    TEST_ASSERT_EQUAL(refused + 1, mock::refusedWrites);
+    mock::failWritesTo = nullptr;
+    mock::clockShiftMs += LOG_RETRY_MIN_MS;
+    for (uint32_t i = 1; i <= LOG_FLUSH_SAMPLES; i++) appendLog(0, t + (6 * LOG_FLUSH_SAMPLES + i) * 60, 2000);
+    TEST_ASSERT_EQUAL(refused + 1, mock::refusedWrites);
+    logFlush();
+}
+
+// Longest loop pass the slicing test accepts on the host
+static const unsigned long PASS_LIMIT_US = 10000;
+
+void test_long_jobs_run_in_slices() {
+    // A whole-log export is handed to a job and written one slice per pass.
+    server.request("/export", {{"from", "0"}});
+    WiFiClient client = server.lastClient();
+    TEST_ASSERT_EQUAL(1, streamJobs());
+    // Room for the whole response, so the mock's copy of it is not
+    // reallocated in the middle of a timed pass
+    client.state().sent.reserve(32u << 20);
+
+    int passes = 0;
+    unsigned long worstUs = 0;
+    while (streamJobs() > 0) {
+        unsigned long start = micros();
+        loop();
+        unsigned long elapsed = micros() - start;
+        if (elapsed > worstUs) worstUs = elapsed;
+        passes++;
+    }
+    printf("\nexport: %d scheduler passes, longest pass %lu us\n", passes, worstUs);
+    TEST_ASSERT_TRUE(passes >= (int)(LOG_CAPACITY / STREAM_SLICE_RECORDS));
+    TEST_ASSERT_TRUE(worstUs <= PASS_LIMIT_US);
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, client.state().sent.find("0\r\n\r\n"));
+
+    // Sealing a day into the archive is sliced as well: no pass copies more
+    // than ARCHIVE_SLICE_RECORDS records.
+    while (logArchive()) {}
+    uint32_t last = getLogMeta(0).lastTime;
+    uint32_t next = (last / 86400 + 1) * 86400;
+    for (uint32_t t = last + 60; t <= next + 86400; t += 60) appendLog(0, t, generatedCenti(t / 60));
+    logFlush();
+    passes = 0;
+    worstUs = 0;
+    unsigned long totalUs = 0;
+    bool more = true;
+    while (more) {
+        unsigned long start = micros();
+        more = logArchive();
+        unsigned long elapsed = micros() - start;
+        totalUs += elapsed;
+        if (elapsed > worstUs) worstUs = elapsed;
+        passes++;
+    }
+    printf("archive: 2 days sealed in %d passes, longest pass %lu us of %lu us\n", passes, worstUs, totalUs);
+    TEST_ASSERT_TRUE(passes >= (int)(1440 / ARCHIVE_SLICE_RECORDS) + 2);
+    TEST_ASSERT_TRUE(worstUs <= PASS_LIMIT_US);
+    DayArchive archive;
+    TEST_ASSERT_TRUE(archive.begin("/log0/arc"));
+    TEST_ASSERT_EQUAL_UINT32(next / 86400 + 1, archive.nextDay());
+
+    ESP8266WebServer::Response r = server.request("/diag");
+    TEST_ASSERT_EQUAL(200, r.code);
+    for (const char *name : {"\"http\"", "\"sensor\"", "\"alarm\"", "\"stream\"", "\"overruns\":"}) {
+        TEST_ASSERT_NOT_EQUAL_MESSAGE(std::string::npos, r.body.find(name), name);
+    }
+}
+
+/**
+ * @brief Flash the archive files of sensor 0 take, in whole blocks.
+ */
+static size_t archiveBytes() {
+    size_t bytes = 0;
+    for (const auto &e : std::filesystem::directory_iterator(".pio/bench_fs/log0")) {
+        if (e.path().filename().string().rfind("arc", 0) == 0) bytes += (e.file_size() + 8191) / 8192 * 8192;
+    }
+    return bytes;
+}
+
+/**
+ * @brief Appends one-minute samples after the newest one up to and
+ *        including `until`, and flushes them.
+ */
+static void appendUntil(uint32_t until) {
+    for (uint32_t t = getLogMeta(0).lastTime + 60; t <= until; t += 60) appendLog(0, t, generatedCenti(t / 60));
+    logFlush();
+}
+
+void test_archive_makes_room() {
+    // On a partition that leaves the archive only what the full rings do
+    // not need, the oldest files go before the next day is sealed.
+    while (logArchive()) {}
+    logEnd();
+    size_t total = mock::fsTotalBytes;
+    mock::fsTotalBytes = 600 * 1024;
+    TEST_ASSERT_TRUE(logBegin(1));
+    size_t rings = RingLog::footprint(sizeof(LogRecord), LOG_CAPACITY) +
+                   RingLog::footprint(sizeof(IndexEntry), LOG_INDEX_CAPACITY) +
+                   RingLog::footprint(sizeof(RollupRecord), ROLLUP_5M_CAPACITY) +
+                   RingLog::footprint(sizeof(RollupRecord), ROLLUP_1H_CAPACITY) +
+                   RingLog::footprint(sizeof(RollupRecord), ROLLUP_1D_CAPACITY) + 3 * 8192;
+    size_t before = archiveBytes();
+    uint32_t day = getLogMeta(0).lastTime / 86400;
+    appendUntil((day + 1) * 86400);
+    while (logArchive()) {}
+    size_t after = archiveBytes();
+    printf("\narchive: %zu bytes before, %zu bytes after sealing on a %zu byte partition\n", before, after,
+           mock::fsTotalBytes);
+    TEST_ASSERT_TRUE(after < before);
+    TEST_ASSERT_TRUE(after + LOG_ARCHIVE_RESERVE <= mock::fsTotalBytes - 2 * 8192 - rings);
+    DayArchive archive;
+    TEST_ASSERT_TRUE(archive.begin("/log0/arc"));
+    TEST_ASSERT_EQUAL_UINT32(day + 1, archive.nextDay());
+
+    // A seal that fails anyway is retried after a delay, not every minute
+    appendUntil((day + 2) * 86400);
+    mock::failWrites = true;
+    while (logArchive()) {}
+    unsigned long writes = mock::fileWrites;
+    TEST_ASSERT_FALSE(logArchive());
+    TEST_ASSERT_EQUAL(writes, mock::fileWrites);
+    mock::failWrites = false;
+    mock::clockShiftMs += LOG_RETRY_MIN_MS;
+    while (logArchive()) {}
+    TEST_ASSERT_TRUE(archive.begin("/log0/arc"));
+    TEST_ASSERT_EQUAL_UINT32(day + 2, archive.nextDay());
+
+    mock::fsTotalBytes = total;
+    logEnd();
+    TEST_ASSERT_TRUE(logBegin(1));
+}
+
+void test_metrics_endpoint() {
+    // Probe cost on its own: an empty scope.
+    const int n = 100000;
+    uint8_t id = metricsRegister("bench");
+    Result probe = measure("METRIC_SCOPE", n, [id]() { METRIC_SCOPE(id); });
+    printf("\nprobe overhead: %.3f us\n", probe.usPerCall);
+    TEST_ASSERT_TRUE(probe.usPerCall < 2.0);
+    TEST_ASSERT_EQUAL(0, probe.peakBytes);
+
+    server.request("/status");
+    ESP8266WebServer::Response r = server.request("/metrics");
+    TEST_ASSERT_EQUAL(200, r.code);
+    for (const char *line : {"tempmon_probe_duration_seconds_count{probe=\"/status\"} ",
+                             "tempmon_probe_duration_seconds_bucket{probe=\"appendLog\",le=\"+Inf\"} ",
+                             "tempmon_probe_duration_seconds_count{probe=\"streamJob\"} ",
+                             "tempmon_heap_free_bytes ", "tempmon_heap_max_block_bytes ",
+                             "tempmon_heap_fragmentation_percent "}) {
+        TEST_ASSERT_NOT_EQUAL_MESSAGE(std::string::npos, r.body.find(line), line);
+    }
+    size_t p = r.body.find("tempmon_probe_duration_seconds_count{probe=\"appendLog\"} ");
+    TEST_ASSERT_TRUE(atol(r.body.c_str() + r.body.find("} ", p) + 2) >= (long)LOG_CAPACITY);
+}
+
+void test_pages_are_gzipped_and_cacheable() {
+    ESP8266WebServer::Response r = server.request("/");
+    TEST_ASSERT_EQUAL(200, r.code);
+    TEST_ASSERT_EQUAL_STRING("gzip", r.headers["Content-Encoding"].c_str());
+    TEST_ASSERT_EQUAL(0x1f, (uint8_t)r.body[0]);
+
+    std::string etag = r.headers["ETag"];
+    r = server.request("/", {}, {{"If-None-Match", etag}});
+    TEST_ASSERT_EQUAL(304, r.code);
+    TEST_ASSERT_TRUE(r.body.empty());
+}
+
+static size_t countFrames(const std::string &sent) {
+    size_t n = 0;
+    for (size_t p = sent.find("data: "); p != std::string::npos; p = sent.find("data: ", p + 1)) n++;
+    return n;
+}
+
+void test_events_push_only_on_change() {
+    server.request("/events");
+    WiFiClient first = server.lastClient();
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, first.state().sent.find("text/event-stream"));
+
+    eventsPoll(millis(), buildEventFrame);
+    eventsPoll(millis(), buildEventFrame);
+    TEST_ASSERT_EQUAL(1, countFrames(first.state().sent));
+
+    currentTemps[0] += 100;
+    eventsPoll(millis(), buildEventFrame);
+    TEST_ASSERT_EQUAL(2, countFrames(first.state().sent));
+
+    // A frame that does not fit is cut at the buffer, not past it
+    char small[32];
+    TEST_ASSERT_EQUAL((int)sizeof(small) - 1, buildEventFrame(0, small, sizeof(small)));
+
+    for (int i = 1; i < SSE_MAX_CLIENTS; i++) TEST_ASSERT_EQUAL(0, server.request("/events").code);
+    TEST_ASSERT_EQUAL(503, server.request("/events").code);
+
+    first.stop();
+    eventsPoll(millis(), buildEventFrame);
+    TEST_ASSERT_EQUAL(SSE_MAX_CLIENTS - 1, eventsSubscribers());
+}
+
+/**
+ * @brief Schema byte of the config record with the highest sequence number
+ *        in the mock flash (header: magic, length, seq, CRC).
+ */
+static uint8_t *newestConfigRecord() {
+    uint8_t *newest = nullptr;
+    uint32_t best = 0;
+    for (auto &entry : mock::flash) {
+        auto &sector = entry.second;
+        for (size_t off = 0; off + 12 <= sector.size();) {
+            uint16_t magic, length;
+            uint32_t seq;
+            memcpy(&magic, &sector[off], 2);
+            memcpy(&length, &sector[off + 2], 2);
+            memcpy(&seq, &sector[off + 4], 4);
+            if (magic != 0xC57A || length > 128) break;
+            if (seq >= best) {
+                best = seq;
+                newest = &sector[off + 12];
+            }
+            off += 12 + ((length + 3) & ~3u);
+        }
+    }
+    return newest;
+}
+
+void test_config_is_journaled() {
+    // A burst of toggles is written once, after it settles, from the task
+    unsigned long writes = mock::flashWrites;
+    for (int i = 0; i < 9; i++) server.request("/toggle_sound");
+    configTask(millis());
+    TEST_ASSERT_EQUAL(writes, mock::flashWrites);
+    configTask(millis() + CONFIG_COMMIT_DELAY_MS);
+    TEST_ASSERT_EQUAL(writes + 1, mock::flashWrites);
+
+    // A burst that ends where it started writes nothing
+    server.request("/toggle_sound");
+    server.request("/toggle_sound");
+    configTask(millis() + CONFIG_COMMIT_DELAY_MS);
+    TEST_ASSERT_EQUAL(writes + 1, mock::flashWrites);
+
+    unsigned long erases = mock::flashErases;
+    const int saves = 500;
+    for (int i = 0; i < saves; i++) {
+        config.limits[1].green = 2000 + i;
+        TEST_ASSERT_TRUE(configCommit());
+    }
+    // One erase per full sector of records
+    const unsigned long perSector = SPI_FLASH_SEC_SIZE / (12 + ((sizeof(SystemConfig) + 3) & ~3u));
+    printf("\nconfig: %d saves, %lu sector erases (%lu records per sector)\n", saves, mock::flashErases - erases, perSector);
+    TEST_ASSERT_TRUE(mock::flashErases - erases <= saves / perSector + 1);
+
+    // Reboot: the newest record wins; a torn newest record falls back one
+    SystemConfig loaded = SystemConfig();
+    TEST_ASSERT_EQUAL(CONFIG_SCHEMA, configBegin(loaded));
+    TEST_ASSERT_EQUAL(2000 + saves - 1, loaded.limits[1].green);
+    *newestConfigRecord() = 0;  // Torn: bits of the schema byte cleared
+    configBegin(loaded);
+    TEST_ASSERT_EQUAL(2000 + saves - 2, loaded.limits[1].green);
+
+    // Power cut right after a sector switch: the erased sector holds only a
+    // torn record, and the previous one is still in the other sector
+    configBegin(config);
+    erases = mock::flashErases;
+    int n = 0;
+    while (mock::flashErases == erases) {
+        config.limits[1].green = 3000 + n++;
+        TEST_ASSERT_TRUE(configCommit());
+    }
+    *newestConfigRecord() = 0;
+    configBegin(loaded);
+    TEST_ASSERT_EQUAL(3000 + n - 2, loaded.limits[1].green);
+    TEST_ASSERT_EQUAL(2u, mock::flash.size());
+
+    // EEPROM image of the single-sensor firmware (in the EEPROM sector, the
+    // higher one): EEPROM.put() of {float green; float yellow; bool sound;},
+    // 12 bytes with padding, in a 512-byte area that was erased before.
+    for (auto &entry : mock::flash) entry.second.fill(0xFF);
+    auto &sector = mock::flash.rbegin()->second;
+    const uint8_t baseline[12] = {0x00, 0x00, 0xAC, 0x41,   // 21.5f
+                                  0x00, 0x00, 0xD2, 0x41,   // 26.25f
+                                  0x00, 0x00, 0x00, 0x00};  // sound off, padding
+    memcpy(sector.data(), baseline, sizeof(baseline));
+    loaded = SystemConfig();
+    for (auto &l : loaded.limits) l = {INT16_MIN, INT16_MIN};
+    loaded.webSoundEnabled = true;
+    TEST_ASSERT_EQUAL(1, configBegin(loaded));
+    TEST_ASSERT_EQUAL(2150, loaded.limits[0].green);
+    TEST_ASSERT_EQUAL(2625, loaded.limits[0].yellow);
+    TEST_ASSERT_FALSE(loaded.webSoundEnabled);
+    for (uint8_t i = 1; i < MAX_SENSORS; i++) TEST_ASSERT_EQUAL(INT16_MIN, loaded.limits[i].green);
+    sector[8] = 1;
+    TEST_ASSERT_EQUAL(1, configBegin(loaded));
+    TEST_ASSERT_TRUE(loaded.webSoundEnabled);
+
+    configBegin(config);
+    TEST_ASSERT_TRUE(configCommit());
+}
+
+static unsigned slotsAssigned = 0;
+static unsigned slotsReused = 0;
+
+static void countAssigned(uint8_t, bool reused) {
+    slotsAssigned++;
+    if (reused) slotsReused++;
+}
+
+/**
+ * @brief Runs one conversion through the sensor pipeline.
+ */
+static void pollOnce(int16_t *centi) {
+    static unsigned long nowMs = 1000000;
+    nowMs += 2000;
+    sensorPoll(nowMs, centi);
+    sensorPoll(nowMs + 1000, centi);
+}
+
+// Probes keep their slot (limits and log) by ROM address when the bus
+// enumerates them in a different order or one goes missing.
+void test_sensors_keep_their_slots() {
+    DallasTemperature bus(nullptr);
+    uint8_t roms[MAX_SENSORS][8] = {};
+    int16_t centi[MAX_SENSORS] = {0, 0, 0, 0};
+    char addr[17];
+    mock::sensorTemps[1] = 21.0f;
+    mock::sensorTemps[2] = 22.0f;
+    mock::sensorTemps[5] = 25.0f;
+    mock::sensorTemps[6] = 26.0f;
+
+    // Empty table (earlier firmware): slots in bus order
+    mock::sensorCount = 2;
+    mock::sensorIds[0] = 1;
+    mock::sensorIds[1] = 2;
+    sensorBegin(bus, SENSOR_RESOLUTION, SENSOR_PERIOD_MS, roms, countAssigned);
+    TEST_ASSERT_EQUAL(2, slotsAssigned);
+    TEST_ASSERT_EQUAL(2, sensorSlots());
+    pollOnce(centi);
+    TEST_ASSERT_EQUAL(2100, centi[0]);
+    TEST_ASSERT_EQUAL(2200, centi[1]);
+
+    // The first probe is unplugged: the second stays in slot 1
+    mock::sensorCount = 1;
+    mock::sensorIds[0] = 2;
+    centi[0] = centi[1] = 0;
+    sensorBegin(bus, SENSOR_RESOLUTION, SENSOR_PERIOD_MS, roms, countAssigned);
+    TEST_ASSERT_EQUAL(2, slotsAssigned);
+    TEST_ASSERT_FALSE(sensorPresent(0));
+    TEST_ASSERT_TRUE(sensorPresent(1));
+    TEST_ASSERT_EQUAL(2, sensorSlots());
+    sensorAddress(0, addr);
+    TEST_ASSERT_EQUAL_STRING("2800000000000001", addr);
+    pollOnce(centi);
+    TEST_ASSERT_EQUAL(0, centi[0]);
+    TEST_ASSERT_EQUAL(2200, centi[1]);
+
+    // A new probe enumerated first takes a free slot, not the missing one's
+    mock::sensorCount = 2;
+    mock::sensorIds[0] = 5;
+    mock::sensorIds[1] = 2;
+    sensorBegin(bus, SENSOR_RESOLUTION, SENSOR_PERIOD_MS, roms, countAssigned);
+    TEST_ASSERT_EQUAL(3, slotsAssigned);
+    TEST_ASSERT_EQUAL(0, slotsReused);
+    TEST_ASSERT_EQUAL(3, sensorSlots());
+    pollOnce(centi);
+    TEST_ASSERT_EQUAL(2200, centi[1]);
+    TEST_ASSERT_EQUAL(2500, centi[2]);
+
+    // Only with every slot assigned is a missing probe's slot reused
+    roms[3][0] = 0x28;
+    roms[3][7] = 7;
+    mock::sensorCount = 3;
+    mock::sensorIds[2] = 6;
+    sensorBegin(bus, SENSOR_RESOLUTION, SENSOR_PERIOD_MS, roms, countAssigned);
+    TEST_ASSERT_EQUAL(4, slotsAssigned);
+    TEST_ASSERT_EQUAL(1, slotsReused);
+    TEST_ASSERT_TRUE(sensorReplaced(0));
+    sensorAddress(0, addr);
+    TEST_ASSERT_EQUAL_STRING("2800000000000006", addr);
+    TEST_ASSERT_TRUE(sensorPresent(0));
+    TEST_ASSERT_FALSE(sensorPresent(3));
+
+    // On the device a reused slot starts over: empty log, default limits,
+    // and flagged on /status
+    uint32_t t = getLogMeta(0).lastTime;
+    for (uint32_t i = 1; i <= LOG_FLUSH_SAMPLES; i++) appendLog(1, t + i * 60, 2000);
+    TEST_ASSERT_EQUAL_UINT32(LOG_FLUSH_SAMPLES, getLogMeta(1).count);
+    config.limits[1] = {1000, 1200};
+    memset(config.sensorRom, 0, sizeof(config.sensorRom));
+    for (uint8_t s = 0; s < MAX_SENSORS; s++) {
+        config.sensorRom[s][0] = 0x28;
+        config.sensorRom[s][7] = s;
+    }
+    mock::sensorCount = 2;
+    mock::sensorIds[0] = 0;
+    mock::sensorIds[1] = 6;
+    sensorBegin(sensors, SENSOR_RESOLUTION, SENSOR_PERIOD_MS, config.sensorRom, sensorAssigned);
+    TEST_ASSERT_TRUE(sensorPresent(0));
+    TEST_ASSERT_TRUE(sensorPresent(1));
+    TEST_ASSERT_EQUAL(6, config.sensorRom[1][7]);
+    loop();
+    // At most the new probe's first sample is left
+    TEST_ASSERT_TRUE(getLogMeta(1).count <= 1);
+    TEST_ASSERT_EQUAL(config.limits[0].green, config.limits[1].green);
+    TEST_ASSERT_EQUAL(config.limits[0].yellow, config.limits[1].yellow);
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, server.request("/status", {{"s", "1"}}).body.find("\"replaced\":true"));
+
+    // Back to the bench probe
+    memset(config.sensorRom[1], 0, 3 * sizeof(config.sensorRom[1]));
+    mock::sensorCount = 1;
+    for (uint8_t i = 0; i < 8; i++) mock::sensorIds[i] = i;
+    sensorBegin(sensors, SENSOR_RESOLUTION, SENSOR_PERIOD_MS, config.sensorRom, sensorAssigned);
+    TEST_ASSERT_TRUE(sensorPresent(0));
+    TEST_ASSERT_EQUAL(1, sensorSlots());
+}
+
+/**
+ * @brief One minute passes on the RTC and the uptime, then the log task runs.
+ */
+static void logMinute() {
+    mock::clockShiftMs += 60000;
+    mock::rtcTime += 60;
+    logSample();
+}
+
+// Samples are logged only at RTC times that can be trusted, and the history
+// is never dropped because the clock jumped.
+void test_clock_set_back() {
+    const LogMeta &meta = getLogMeta(0);
+    uint32_t t = meta.lastTime + 86400;
+    for (int i = 0; i < 30; i++) appendLog(0, t + i * 60, 2000);
+    uint32_t first = meta.firstTime, count = meta.count, last = meta.lastTime;
+    TEST_ASSERT_EQUAL_UINT32(t + 29 * 60, last);
+
+    // Set back by a minute or by days: dropped until the clock passes the
+    // last sample, and the history stays
+    appendLog(0, last, 2100);
+    appendLog(0, last - 3600, 2100);
+    appendLog(0, last - 3 * 86400, 2100);
+    TEST_ASSERT_EQUAL_UINT32(count, meta.count);
+    TEST_ASSERT_EQUAL_UINT32(first, meta.firstTime);
+    TEST_ASSERT_EQUAL_UINT32(last, meta.lastTime);
+    appendLog(0, last + 60, 2100);
+    TEST_ASSERT_EQUAL_UINT32(last + 60, meta.lastTime);
+
+    // Through the log task, a reading that jumped is held back until the
+    // next one agrees with it
+    mock::rtcTime = last + 120;
+    logSample();
+    TEST_ASSERT_EQUAL_UINT32(last + 60, meta.lastTime);
+    logMinute();
+    TEST_ASSERT_EQUAL_UINT32(mock::rtcTime, meta.lastTime);
+
+    // A garbled I2C read costs that sample and the next, which disagrees
+    // with it
+    last = meta.lastTime;
+    mock::rtcGlitches = 1;
+    logMinute();
+    logMinute();
+    TEST_ASSERT_EQUAL_UINT32(last, meta.lastTime);
+    logMinute();
+    TEST_ASSERT_EQUAL_UINT32(mock::rtcTime, meta.lastTime);
+
+    // Lost power: the clock restarted at 2000-01-01; nothing is logged or
+    // dropped until it is set
+    last = meta.lastTime;
+    first = meta.firstTime;
+    mock::rtcLostPower = true;
+    mock::rtcTime = 946684800;
+    logMinute();
+    logMinute();
+    TEST_ASSERT_EQUAL_UINT32(last, meta.lastTime);
+    TEST_ASSERT_EQUAL_UINT32(first, meta.firstTime);
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, server.request("/status").body.find("\"clockLost\":true"));
+    DateTime set(last + 3600);
+    char dt[24];
+    snprintf(dt, sizeof(dt), "%04u-%02u-%02uT%02u:%02u", set.year(), set.month(), set.day(), set.hour(), set.minute());
+    server.request("/save_time", {{"dt", dt}});
+    TEST_ASSERT_FALSE(mock::rtcLostPower);
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, server.request("/status").body.find("\"clockLost\":false"));
+    logMinute();
+    TEST_ASSERT_EQUAL_UINT32(mock::rtcTime, meta.lastTime);
+
+    // A clock that reads before LOG_CLOCK_MIN was never set
+    mock::rtcTime = LOG_CLOCK_MIN - 60;
+    logTime();
+    mock::clockShiftMs += 60000;
+    mock::rtcTime += 59;
+    TEST_ASSERT_EQUAL_UINT32(0, logTime());
+    mock::clockShiftMs += 1000;
+    mock::rtcTime += 1;
+    TEST_ASSERT_EQUAL_UINT32(LOG_CLOCK_MIN, logTime());
+}
+
+void setUp() {}
+void tearDown() {}
+
+int main() {
+    std::filesystem::remove_all(".pio/bench_fs");
+    LittleFS.setRoot(".pio/bench_fs");
+    mock::sensorCount = 1;
+    mock::rtcTime = START_TIME;
+    mock::wifiStatus = WL_DISCONNECTED;
+    setup();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_boot_does_not_wait_for_wifi);
+    RUN_TEST(test_generate_and_measure);
+    RUN_TEST(test_status_is_independent_of_log_size);
+    RUN_TEST(test_history_heap_is_constant);
+    RUN_TEST(test_history_returns_bins);
+    RUN_TEST(test_history_stats_envelope);
+    RUN_TEST(test_history_chart_is_self_contained);
+    RUN_TEST(test_fixed_point_round_trip);
+    RUN_TEST(test_index_points_at_bucket_start);
+    RUN_TEST(test_ring_is_segmented);
+    RUN_TEST(test_export_range_and_step);
+    RUN_TEST(test_archive_is_compact_and_lossless);
+    RUN_TEST(test_staged_samples_survive_reset);
+    RUN_TEST(test_log_fits_and_retries);
+    RUN_TEST(test_tier_bins_survive_failed_writes);
+    RUN_TEST(test_long_jobs_run_in_slices);
+    RUN_TEST(test_archive_makes_room);
+    RUN_TEST(test_metrics_endpoint);
+    RUN_TEST(test_pages_are_gzipped_and_cacheable);
+    RUN_TEST(test_events_push_only_on_change);
+    RUN_TEST(test_config_is_journaled);
+    RUN_TEST(test_sensors_keep_their_slots);
+    RUN_TEST(test_clock_set_back);
+    return UNITY_END();
+}
@@ -0,0 +1,85 @@
+"""
+Pre-build step: minifies and gzips the pages in include/WebPages.h into
+PROGMEM byte arrays in include/WebPagesGz.h.
+
+Each page gets <NAME>_GZ, <NAME>_GZ_LEN and <NAME>_ETAG (a hash of the
+compressed bytes). The output is only rewritten when it changes, so the
+firmware is not rebuilt needlessly. Runs automatically as a PlatformIO
+extra script and can also be run by hand: python tools/build_web.py
+"""
+
+import gzip
+import hashlib
+import os
+import re
+
+try:
+    Import("env")  # noqa: F821 - provided by PlatformIO
+    PROJECT_DIR = env["PROJECT_DIR"]  # noqa: F821
+except NameError:
+    PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+SOURCE = os.path.join(PROJECT_DIR, "include", "WebPages.h")
+TARGET = os.path.join(PROJECT_DIR, "include", "WebPagesGz.h")
+
+PAGE_RE = re.compile(r'const char (\w+)\[\] PROGMEM = R"====\((.*?)\)====";', re.S)
+
+
+def minify(html):
+    # Indentation and blank lines only; line breaks are kept so inline
+    # scripts that rely on them stay valid.
+    lines = (line.strip() for line in html.splitlines())
+    return "\n".join(line for line in lines if line)
+
+
+def c_array(data):
+    rows = []
+    for i in range(0, len(data), 20):
+        rows.append("    " + ",".join("0x%02x" % b for b in data[i:i + 20]) + ",")
+    return "\n".join(rows)
+
+
+def render(pages):
+    out = [
+        "/**",
+        " * @file WebPagesGz.h",
+        " * @brief Gzip-compressed pages generated from WebPages.h.",
+        " * @details Generated by tools/build_web.py - do not edit.",
+        " */",
+        "",
+        "#ifndef WEB_PAGES_GZ_H",
+        "#define WEB_PAGES_GZ_H",
+        "",
+        "#include <Arduino.h>",
+        "",
+    ]
+    for name, html in pages:
+        raw = minify(html).encode("utf-8")
+        # mtime=0 keeps the output (and the ETag) identical between builds.
+        data = gzip.compress(raw, compresslevel=9, mtime=0)
+        etag = hashlib.sha1(data).hexdigest()[:16]
+        out.append("// %s: %d bytes -> %d bytes gzipped" % (name, len(html.encode("utf-8")), len(data)))
+        out.append("const uint8_t %s_GZ[] PROGMEM = {" % name)
+        out.append(c_array(data))
+        out.append("};")
+        out.append("const size_t %s_GZ_LEN = %d;" % (name, len(data)))
+        out.append('const char %s_ETAG[] = "\\"%s\\"";' % (name, etag))
+        out.append("")
+    out.append("#endif // WEB_PAGES_GZ_H")
+    return "\n".join(out) + "\n"
+
+
+def main():
+    with open(SOURCE, encoding="utf-8") as f:
+        pages = PAGE_RE.findall(f.read())
+    content = render(pages)
+    if os.path.exists(TARGET):
+        with open(TARGET, encoding="utf-8") as f:
+            if f.read() == content:
+                return
+    with open(TARGET, "w", encoding="utf-8") as f:
+        f.write(content)
+    print("build_web: regenerated %s (%d pages)" % (os.path.relpath(TARGET, PROJECT_DIR), len(pages)))
+
+
+main()